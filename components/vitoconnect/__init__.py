@@ -1,7 +1,8 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
-from esphome.components import uart
-from esphome.const import CONF_ID, CONF_PROTOCOL, CONF_UPDATE_INTERVAL
+from esphome import automation
+from esphome.components import uart, time
+from esphome.const import CONF_ID, CONF_ADDRESS, CONF_PROTOCOL, CONF_TIME_ID, CONF_TRIGGER_ID, CONF_UPDATE_INTERVAL
 
 CODEOWNERS = ["@dannerph"]
 
@@ -11,25 +12,103 @@ MULTI_CONF = True
 
 vitoconnect_ns = cg.esphome_ns.namespace("vitoconnect")
 VitoConnect = vitoconnect_ns.class_("VitoConnect", uart.UARTDevice, cg.PollingComponent)
+Datapoint = vitoconnect_ns.class_("Datapoint")
+DatapointListener = vitoconnect_ns.class_("DatapointListener")
+DatapointGroup = vitoconnect_ns.class_("DatapointGroup")
+ErrorTrigger = vitoconnect_ns.class_("ErrorTrigger", automation.Trigger.template(cg.uint8))
+ClockSync = vitoconnect_ns.class_("ClockSync", Datapoint)
 
 CONF_VITOCONNECT_ID = "vitoconnect_id"
+CONF_GROUPS = "groups"
+CONF_GROUP = "group"
+CONF_MAX_GAP = "max_gap"
+CONF_STALE_FACTOR = "stale_factor"
+CONF_QUARANTINE_AFTER = "quarantine_after"
+CONF_REPROBE_INTERVAL = "reprobe_interval"
+CONF_DIAGNOSTICS_INTERVAL = "diagnostics_interval"
+CONF_ON_ERROR = "on_error"
+CONF_PUBLISH_BUDGET = "publish_budget"
+CONF_PUBLISH_TIME_BUDGET = "publish_time_budget"
+CONF_WRITE_RETRIES = "write_retries"
+CONF_CLOCK_SYNC = "clock_sync"
+CONF_MAX_DRIFT = "max_drift"
+CONF_INTERVAL = "interval"
+CONF_TRACE = "trace"
 
 OPTOLINK_PROTOCOL = {
     "P300": "P300",
     "KW":"KW",
 }
 
+GROUP_SCHEMA = cv.Schema(
+    {
+        cv.Required(CONF_ID): cv.declare_id(DatapointGroup),
+        cv.Optional(CONF_MAX_GAP, default=0): cv.int_range(min=0, max=8),
+    }
+)
+
+CLOCK_SYNC_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(ClockSync),
+        cv.Required(CONF_TIME_ID): cv.use_id(time.RealTimeClock),
+        cv.Optional(CONF_ADDRESS, default=0x088E): cv.uint16_t,
+        cv.Optional(CONF_INTERVAL, default="1h"): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_MAX_DRIFT, default="30s"): cv.All(
+            cv.positive_time_period_seconds, cv.Range(min=cv.TimePeriod(seconds=1))
+        ),
+    }
+)
+
 CONFIG_SCHEMA = (
     cv.Schema(
         {
             cv.GenerateID(): cv.declare_id(VitoConnect),
             cv.Required(CONF_PROTOCOL): cv.enum(OPTOLINK_PROTOCOL, upper=True, space="_"),
             cv.Optional(CONF_UPDATE_INTERVAL, default="60s"): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_GROUPS): cv.ensure_list(GROUP_SCHEMA),
+            cv.Optional(CONF_STALE_FACTOR, default=0): cv.int_range(min=0, max=255),
+            cv.Optional(CONF_QUARANTINE_AFTER, default=0): cv.int_range(min=0, max=255),
+            cv.Optional(CONF_REPROBE_INTERVAL, default="1h"): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_DIAGNOSTICS_INTERVAL, default="0s"): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_PUBLISH_BUDGET, default=0): cv.int_range(min=0, max=255),
+            cv.Optional(CONF_PUBLISH_TIME_BUDGET, default="0us"): cv.positive_time_period_microseconds,
+            cv.Optional(CONF_WRITE_RETRIES): cv.int_range(min=0, max=7),
+            cv.Optional(CONF_CLOCK_SYNC): CLOCK_SYNC_SCHEMA,
+            cv.Optional(CONF_TRACE, default=False): cv.boolean,
         }
     )
     .extend(uart.UART_DEVICE_SCHEMA)
 )
 
+# Common options of all entities backed by a datapoint
+DATAPOINT_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(CONF_VITOCONNECT_ID): cv.use_id(VitoConnect),
+        cv.Optional(CONF_GROUP): cv.use_id(DatapointGroup),
+        cv.Optional(CONF_ON_ERROR): automation.validate_automation(
+            {
+                cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(ErrorTrigger),
+            }
+        ),
+    }
+)
+
+
+async def register_datapoint(var, config):
+    # Add datapoint to its read group
+    if CONF_GROUP in config:
+        group = await cg.get_variable(config[CONF_GROUP])
+        cg.add(group.add_datapoint(var))
+
+    # Triggers for failed requests, the error code is passed as 'error'
+    for conf in config.get(CONF_ON_ERROR, []):
+        trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
+        await automation.build_automation(trigger, [(cg.uint8, "error")], conf)
+
+    # Add datapoint to component hub (VitoConnect)
+    hub = await cg.get_variable(config[CONF_VITOCONNECT_ID])
+    cg.add(hub.register_datapoint(var))
+
 
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
@@ -37,3 +116,28 @@ async def to_code(config):
     await uart.register_uart_device(var, config)
     cg.add(var.set_protocol(config[CONF_PROTOCOL]))
     cg.add(var.set_update_interval(config[CONF_UPDATE_INTERVAL]))
+    cg.add(var.set_stale_factor(config[CONF_STALE_FACTOR]))
+    cg.add(var.set_quarantine_after(config[CONF_QUARANTINE_AFTER]))
+    cg.add(var.set_reprobe_interval(config[CONF_REPROBE_INTERVAL]))
+    cg.add(var.set_diagnostics_interval(config[CONF_DIAGNOSTICS_INTERVAL]))
+    cg.add(var.set_publish_budget(config[CONF_PUBLISH_BUDGET]))
+    cg.add(var.set_publish_time_budget(config[CONF_PUBLISH_TIME_BUDGET]))
+    if CONF_WRITE_RETRIES in config:
+        cg.add(var.set_write_retries(config[CONF_WRITE_RETRIES]))
+    cg.add(var.set_trace(config[CONF_TRACE]))
+
+    # Device time, read on its own interval and corrected once it drifts too far
+    if CONF_CLOCK_SYNC in config:
+        clock_config = config[CONF_CLOCK_SYNC]
+        time_source = await cg.get_variable(clock_config[CONF_TIME_ID])
+        clock = cg.new_Pvariable(clock_config[CONF_ID], time_source)
+        cg.add(clock.setAddress(clock_config[CONF_ADDRESS]))
+        cg.add(clock.setLength(8))
+        cg.add(clock.setPollInterval(clock_config[CONF_INTERVAL]))
+        cg.add(clock.set_max_drift(clock_config[CONF_MAX_DRIFT]))
+        cg.add(var.register_datapoint(clock))
+
+    for group_config in config.get(CONF_GROUPS, []):
+        group = cg.new_Pvariable(group_config[CONF_ID])
+        cg.add(group.set_max_gap(group_config[CONF_MAX_GAP]))
+        cg.add(var.register_group(group))
@@ -2,16 +2,15 @@ import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import binary_sensor
 from esphome.const import CONF_ADDRESS
-from .. import vitoconnect_ns, VitoConnect, CONF_VITOCONNECT_ID
+from .. import vitoconnect_ns, Datapoint, DATAPOINT_SCHEMA, register_datapoint
 
 DEPENDENCIES = ["vitoconnect"]
-OPTOLINKBinarySensor = vitoconnect_ns.class_("OPTOLINKBinarySensor", binary_sensor.BinarySensor)
+OPTOLINKBinarySensor = vitoconnect_ns.class_("OPTOLINKBinarySensor", binary_sensor.BinarySensor, Datapoint)
 
 CONFIG_SCHEMA =  binary_sensor.binary_sensor_schema(OPTOLINKBinarySensor).extend({
     cv.GenerateID(): cv.declare_id(OPTOLINKBinarySensor),
-    cv.GenerateID(CONF_VITOCONNECT_ID): cv.use_id(VitoConnect),
     cv.Required(CONF_ADDRESS): cv.uint16_t
-})
+}).extend(DATAPOINT_SCHEMA)
 
 async def to_code(config):
     var = await binary_sensor.new_binary_sensor(config)
@@ -21,5 +20,4 @@ async def to_code(config):
     cg.add(var.setLength(1))
 
     # Add sensor to component hub (VitoConnect)
-    hub = await cg.get_variable(config[CONF_VITOCONNECT_ID])
-    cg.add(hub.register_datapoint(var))
+    await register_datapoint(var, config)
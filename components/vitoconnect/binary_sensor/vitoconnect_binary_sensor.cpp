@@ -21,6 +21,11 @@ void OPTOLINKBinarySensor::decode(uint8_t* data, uint8_t length, Datapoint* dp)
   publish_state(data[0]);
 }
 
+void OPTOLINKBinarySensor::invalidate() {
+  ESP_LOGD(TAG, "Value of binary sensor %s is outdated", this->get_name().c_str());
+  invalidate_state();
+}
+
 void OPTOLINKBinarySensor::encode(uint8_t* raw, uint8_t length, void* data) {
   float value = *reinterpret_cast<float*>(data);
   encode(raw, length, value);
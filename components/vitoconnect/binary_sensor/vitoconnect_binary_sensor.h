@@ -15,6 +15,7 @@ class OPTOLINKBinarySensor : public binary_sensor::BinarySensor, public Datapoin
     void decode(uint8_t* data, uint8_t length, Datapoint* dp = nullptr) override;
     void encode(uint8_t* raw, uint8_t length, void* data) override;
     void encode(uint8_t* raw, uint8_t length, float data);
+    void invalidate() override;
 
 };
 
@@ -0,0 +1,119 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import climate
+from esphome.const import CONF_ID, CONF_TYPE, CONF_ADDRESS, CONF_LENGTH, CONF_DIV_RATIO, CONF_MODE, CONF_TARGET_TEMPERATURE, CONF_CURRENT_TEMPERATURE
+from .. import vitoconnect_ns, Datapoint, DatapointGroup, VitoConnect, CONF_VITOCONNECT_ID
+
+DEPENDENCIES = ["vitoconnect"]
+OPTOLINKClimate = vitoconnect_ns.class_("OPTOLINKClimate", climate.Climate, cg.Component)
+OPTOLINKWaterHeater = vitoconnect_ns.class_("OPTOLINKWaterHeater", OPTOLINKClimate)
+ClimateDatapoint = vitoconnect_ns.class_("ClimateDatapoint", Datapoint)
+
+CONF_ACTION = "action"
+CONF_MODES = "modes"
+CONF_CLIMATE_GROUP_ID = "climate_group_id"
+CONF_PUMP = "pump"
+CONF_ONE_TIME_CHARGE = "one_time_charge"
+CONF_IDLE_INTERVAL = "idle_interval"
+
+TYPE_HEATING_CIRCUIT = "heating_circuit"
+TYPE_WATER_HEATER = "water_heater"
+
+VALUE_SCHEMA = cv.Schema({
+    cv.GenerateID(): cv.declare_id(ClimateDatapoint),
+    cv.Required(CONF_ADDRESS): cv.uint16_t,
+    cv.Optional(CONF_LENGTH, default=2): cv.one_of(1, 2, int=True),
+    cv.Optional(CONF_DIV_RATIO, default=10): cv.one_of(1, 2, 10, 100, int=True),
+})
+
+MODE_SCHEMA = cv.Schema({
+    cv.GenerateID(): cv.declare_id(ClimateDatapoint),
+    cv.Required(CONF_ADDRESS): cv.uint16_t,
+    cv.Required(CONF_MODES): cv.Schema({cv.enum(climate.CLIMATE_MODES, upper=True): cv.uint8_t}),
+})
+
+FLAG_SCHEMA = cv.Schema({
+    cv.GenerateID(): cv.declare_id(ClimateDatapoint),
+    cv.Required(CONF_ADDRESS): cv.uint16_t,
+})
+
+BASE_SCHEMA = climate.CLIMATE_SCHEMA.extend({
+    cv.GenerateID(CONF_VITOCONNECT_ID): cv.use_id(VitoConnect),
+    cv.GenerateID(CONF_CLIMATE_GROUP_ID): cv.declare_id(DatapointGroup),
+    cv.Required(CONF_TARGET_TEMPERATURE): VALUE_SCHEMA,
+}).extend(cv.COMPONENT_SCHEMA)
+
+CONFIG_SCHEMA = cv.typed_schema(
+    {
+        TYPE_HEATING_CIRCUIT: BASE_SCHEMA.extend({
+            cv.GenerateID(): cv.declare_id(OPTOLINKClimate),
+            cv.Optional(CONF_CURRENT_TEMPERATURE): VALUE_SCHEMA,
+            cv.Optional(CONF_MODE): MODE_SCHEMA,
+            cv.Optional(CONF_ACTION): FLAG_SCHEMA,
+        }),
+        TYPE_WATER_HEATER: BASE_SCHEMA.extend({
+            cv.GenerateID(): cv.declare_id(OPTOLINKWaterHeater),
+            cv.Required(CONF_CURRENT_TEMPERATURE): VALUE_SCHEMA,
+            cv.Required(CONF_PUMP): FLAG_SCHEMA,
+            cv.Optional(CONF_ONE_TIME_CHARGE): FLAG_SCHEMA,
+            cv.Optional(CONF_IDLE_INTERVAL, default="10min"): cv.positive_time_period_milliseconds,
+        }),
+    },
+    default_type=TYPE_HEATING_CIRCUIT,
+)
+
+
+async def register_member(parent, group, hub, config, length, div_ratio):
+    dp = cg.new_Pvariable(config[CONF_ID], parent)
+    cg.add(dp.setAddress(config[CONF_ADDRESS]))
+    cg.add(dp.setLength(length))
+    cg.add(dp.setDivRatio(div_ratio))
+    if group is not None:
+        cg.add(group.add_datapoint(dp))
+    cg.add(hub.register_datapoint(dp))
+    return dp
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    await climate.register_climate(var, config)
+
+    # all members are read as one group, merged into block reads where possible
+    hub = await cg.get_variable(config[CONF_VITOCONNECT_ID])
+    group = cg.new_Pvariable(config[CONF_CLIMATE_GROUP_ID])
+    cg.add(hub.register_group(group))
+
+    # the mode is registered first so it is written ahead of the setpoint
+    if CONF_MODE in config:
+        conf = config[CONF_MODE]
+        dp = await register_member(var, group, hub, conf, 1, 1)
+        cg.add(var.set_mode(dp))
+        for mode, raw in conf[CONF_MODES].items():
+            cg.add(var.add_mode(mode, raw))
+
+    conf = config[CONF_TARGET_TEMPERATURE]
+    dp = await register_member(var, group, hub, conf, conf[CONF_LENGTH], conf[CONF_DIV_RATIO])
+    cg.add(var.set_target_temperature(dp))
+
+    if CONF_CURRENT_TEMPERATURE in config:
+        conf = config[CONF_CURRENT_TEMPERATURE]
+        dp = await register_member(var, group, hub, conf, conf[CONF_LENGTH], conf[CONF_DIV_RATIO])
+        cg.add(var.set_current_temperature(dp))
+
+    if CONF_ACTION in config:
+        dp = await register_member(var, group, hub, config[CONF_ACTION], 1, 1)
+        cg.add(var.set_action(dp))
+
+    if config[CONF_TYPE] == TYPE_WATER_HEATER:
+        cg.add(var.set_group(group))
+        cg.add(var.set_idle_interval(config[CONF_IDLE_INTERVAL]))
+        cg.add(group.setPollInterval(config[CONF_IDLE_INTERVAL]))
+
+        # the pump is polled every cycle outside of the group, it switches the group to fast refresh
+        dp = await register_member(var, None, hub, config[CONF_PUMP], 1, 1)
+        cg.add(var.set_action(dp))
+
+        if CONF_ONE_TIME_CHARGE in config:
+            dp = await register_member(var, group, hub, config[CONF_ONE_TIME_CHARGE], 1, 1)
+            cg.add(var.set_charge(dp))
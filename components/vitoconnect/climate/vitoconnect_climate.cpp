@@ -0,0 +1,139 @@
+#include "vitoconnect_climate.h"
+
+namespace esphome {
+namespace vitoconnect {
+
+static const char *TAG = "vitoconnect.climate";
+
+void ClimateDatapoint::decode(uint8_t* data, uint8_t length, Datapoint* dp) {
+  assert(length >= _length);
+  if (_length == 1) {
+    _value = data[0] / (float) _div_ratio;
+  } else {
+    int16_t tmp = data[1] << 8 | data[0];
+    _value = tmp / (float) _div_ratio;
+  }
+  _parent->memberChanged();
+}
+
+void ClimateDatapoint::encode(uint8_t* raw, uint8_t length) {
+  assert(length >= _length);
+  float value = _value * _div_ratio;
+  if (_length == 1) {
+    raw[0] = (uint8_t) floor(value + 0.5f);
+  } else {
+    int16_t tmp = floor(value + 0.5f);
+    raw[1] = tmp >> 8;
+    raw[0] = tmp & 0xFF;
+  }
+}
+
+void ClimateDatapoint::invalidate() {
+  _value = NAN;
+  _parent->memberChanged();
+}
+
+void OPTOLINKClimate::memberChanged() {
+  // members of a group are decoded in the same loop pass
+  this->defer("publish", [this]() {
+    this->_update();
+    this->publish_state();
+  });
+}
+
+void OPTOLINKClimate::_update() {
+  if (_current) this->current_temperature = _current->getValue();
+  if (_target) this->target_temperature = _target->getValue();
+  if (_mode && !std::isnan(_mode->getValue())) {
+    uint8_t raw = (uint8_t) _mode->getValue();
+    bool found = false;
+    for (auto &mode : _modes) {
+      if (mode.second == raw) {
+        this->mode = mode.first;
+        found = true;
+        break;
+      }
+    }
+    if (!found) ESP_LOGW(TAG, "raw mode %d of climate %s has no mapping", raw, this->get_name().c_str());
+  } else if (!_mode) {
+    this->mode = climate::CLIMATE_MODE_HEAT;  // the only mode offered without a mode datapoint
+  }
+  if (_action && !std::isnan(_action->getValue())) {
+    if (_action->getValue() != 0.0f) {
+      this->action = climate::CLIMATE_ACTION_HEATING;
+    } else {
+      this->action = this->mode == climate::CLIMATE_MODE_OFF ? climate::CLIMATE_ACTION_OFF : climate::CLIMATE_ACTION_IDLE;
+    }
+  }
+}
+
+void OPTOLINKClimate::control(const climate::ClimateCall &call) {
+  // the mode datapoint is registered first, so it is also written first
+  if (call.get_mode().has_value() && _mode) {
+    for (auto &mode : _modes) {
+      if (mode.first == *call.get_mode()) {
+        ESP_LOGI(TAG, "mode of climate %s to raw value %d", this->get_name().c_str(), mode.second);
+        _mode->setValue(mode.second);
+        _mode->markPending();
+        this->mode = mode.first;
+      }
+    }
+  }
+  if (call.get_target_temperature().has_value() && _target) {
+    ESP_LOGI(TAG, "target temperature of climate %s to %f", this->get_name().c_str(), *call.get_target_temperature());
+    _target->setValue(*call.get_target_temperature());
+    _target->markPending();
+    this->target_temperature = *call.get_target_temperature();
+  }
+  this->publish_state();
+}
+
+climate::ClimateTraits OPTOLINKClimate::traits() {
+  climate::ClimateTraits traits;
+  traits.set_supports_current_temperature(_current != nullptr);
+  traits.set_supports_action(_action != nullptr);
+  if (_modes.empty()) {
+    traits.add_supported_mode(climate::CLIMATE_MODE_HEAT);
+  }
+  for (auto &mode : _modes) {
+    traits.add_supported_mode(mode.first);
+  }
+  return traits;
+}
+
+void OPTOLINKWaterHeater::_update() {
+  OPTOLINKClimate::_update();
+
+  // refresh the tank every cycle while it is being charged
+  bool charging = this->action == climate::CLIMATE_ACTION_HEATING;
+  if (_group && _group->getPollInterval() != (charging ? 0 : _idleInterval)) {
+    ESP_LOGD(TAG, "water heater %s %s, switching refresh interval", this->get_name().c_str(), charging ? "charging" : "idle");
+    _group->setPollInterval(charging ? 0 : _idleInterval);
+  }
+
+  if (_charge && !std::isnan(_charge->getValue())) {
+    this->preset = _charge->getValue() != 0.0f ? climate::CLIMATE_PRESET_BOOST : climate::CLIMATE_PRESET_NONE;
+  }
+}
+
+void OPTOLINKWaterHeater::control(const climate::ClimateCall &call) {
+  if (call.get_preset().has_value() && _charge) {
+    bool boost = *call.get_preset() == climate::CLIMATE_PRESET_BOOST;
+    ESP_LOGI(TAG, "one-time charge of water heater %s %s", this->get_name().c_str(), boost ? "on" : "off");
+    _charge->setValue(boost ? 1 : 0);
+    _charge->markPending();
+    this->preset = *call.get_preset();
+  }
+  OPTOLINKClimate::control(call);
+}
+
+climate::ClimateTraits OPTOLINKWaterHeater::traits() {
+  climate::ClimateTraits traits = OPTOLINKClimate::traits();
+  if (_charge) {
+    traits.set_supported_presets({climate::CLIMATE_PRESET_NONE, climate::CLIMATE_PRESET_BOOST});
+  }
+  return traits;
+}
+
+}  // namespace vitoconnect
+}  // namespace esphome
\ No newline at end of file
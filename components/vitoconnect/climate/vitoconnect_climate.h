@@ -0,0 +1,96 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "esphome/core/component.h"
+#include "esphome/components/climate/climate.h"
+#include "../vitoconnect_datapoint.h"
+#include "../vitoconnect_group.h"
+
+namespace esphome {
+namespace vitoconnect {
+
+class OPTOLINKClimate;
+
+/**
+ * @brief Numeric member of a composite climate entity.
+ */
+class ClimateDatapoint : public Datapoint {
+
+  public:
+    explicit ClimateDatapoint(OPTOLINKClimate* parent) : _parent(parent) {}
+
+    void setDivRatio(uint16_t ratio) { this->_div_ratio = ratio; }
+    float getValue() { return this->_value; }
+    void setValue(float value) { this->_value = value; }
+
+    void decode(uint8_t* data, uint8_t length, Datapoint* dp = nullptr) override;
+    void encode(uint8_t* raw, uint8_t length) override;
+    void invalidate() override;
+
+  protected:
+    OPTOLINKClimate* _parent;
+    uint16_t _div_ratio = 1;
+    float _value = NAN;
+
+};
+
+/**
+ * @brief Climate entity of a heating circuit, composed of several datapoints
+ *        that are read as one group. The state is published once after all
+ *        members of a read have been decoded.
+ */
+class OPTOLINKClimate : public climate::Climate, public Component {
+
+  public:
+    void set_current_temperature(ClimateDatapoint* dp) { this->_current = dp; }
+    void set_target_temperature(ClimateDatapoint* dp) { this->_target = dp; }
+    void set_mode(ClimateDatapoint* dp) { this->_mode = dp; }
+    void set_action(ClimateDatapoint* dp) { this->_action = dp; }
+    void add_mode(climate::ClimateMode mode, uint8_t raw) { this->_modes.push_back({mode, raw}); }
+
+    /**
+     * @brief Called by the members once decoded, coalesces them into one publish.
+     */
+    void memberChanged();
+
+  protected:
+    void control(const climate::ClimateCall &call) override;
+    climate::ClimateTraits traits() override;
+    virtual void _update();
+
+    ClimateDatapoint* _current = nullptr;
+    ClimateDatapoint* _target = nullptr;
+    ClimateDatapoint* _mode = nullptr;
+    ClimateDatapoint* _action = nullptr;
+    std::vector<std::pair<climate::ClimateMode, uint8_t>> _modes;
+
+};
+
+/**
+ * @brief Domestic hot water as climate entity. The charging pump is polled
+ *        every cycle, the other members are read as group at the idle
+ *        interval and every cycle while the pump runs. A one-time charge is
+ *        exposed as BOOST preset.
+ */
+class OPTOLINKWaterHeater : public OPTOLINKClimate {
+
+  public:
+    void set_charge(ClimateDatapoint* dp) { this->_charge = dp; }
+    void set_group(DatapointGroup* group) { this->_group = group; }
+    void set_idle_interval(uint32_t interval) { this->_idleInterval = interval; }
+
+  protected:
+    void control(const climate::ClimateCall &call) override;
+    climate::ClimateTraits traits() override;
+    void _update() override;
+
+    ClimateDatapoint* _charge = nullptr;
+    DatapointGroup* _group = nullptr;
+    uint32_t _idleInterval = 0;
+
+};
+
+}  // namespace vitoconnect
+}  // namespace esphome
\ No newline at end of file
@@ -2,23 +2,31 @@ import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import number
 from esphome.const import CONF_ID, CONF_NAME, CONF_ADDRESS, CONF_LENGTH, CONF_DIV_RATIO, CONF_MAX_VALUE, CONF_MIN_VALUE, CONF_STEP #, CONF_TYPE 
-from .. import vitoconnect_ns, VitoConnect, CONF_VITOCONNECT_ID
+from .. import vitoconnect_ns, Datapoint, DATAPOINT_SCHEMA, register_datapoint
 
 DEPENDENCIES = ["vitoconnect"]
-OPTOLINKNumber = vitoconnect_ns.class_("OPTOLINKNumber", number.Number)
+CONF_MASK = "mask"
+OPTOLINKNumber = vitoconnect_ns.class_("OPTOLINKNumber", number.Number, Datapoint)
 
 CONFIG_SCHEMA = number.number_schema(OPTOLINKNumber).extend({
     cv.GenerateID(): cv.declare_id(OPTOLINKNumber),
-    cv.GenerateID(CONF_VITOCONNECT_ID): cv.use_id(VitoConnect),
     cv.Required(CONF_ADDRESS): cv.uint16_t,
     cv.Required(CONF_LENGTH): cv.uint8_t,
+    cv.Optional(CONF_MASK): cv.All(cv.hex_uint8_t, cv.Range(min=1)),
     cv.Required(CONF_MAX_VALUE): cv.float_,
     cv.Required(CONF_MIN_VALUE): cv.float_range(),
     cv.Required(CONF_STEP): cv.float_,
     cv.Optional(CONF_DIV_RATIO, default=1): cv.one_of(
             1, 2, 10, 3600, int=True
         ),
-})
+}).extend(DATAPOINT_SCHEMA)
+
+def validate_mask(config):
+    if CONF_MASK in config and config[CONF_LENGTH] != 1:
+        raise cv.Invalid("mask is only supported for datapoints with length 1")
+    return config
+
+CONFIG_SCHEMA = cv.All(CONFIG_SCHEMA, validate_mask)
 
 async def to_code(config):
     var = await number.new_number(
@@ -33,7 +41,8 @@ async def to_code(config):
     cg.add(var.setAddress(config[CONF_ADDRESS]))
     cg.add(var.setLength(config[CONF_LENGTH]))
     cg.add(var.setDivRatio(config[CONF_DIV_RATIO]))
+    if CONF_MASK in config:
+        cg.add(var.setMask(config[CONF_MASK]))
 
     # Add sensor to component hub (VitoConnect)
-    hub = await cg.get_variable(config[CONF_VITOCONNECT_ID])
-    cg.add(hub.register_datapoint(var))
+    await register_datapoint(var, config)
@@ -30,7 +30,7 @@ void OPTOLINKNumber::control(float value) {
 
   ESP_LOGD(TAG, "state of number %s to value: %f", this->get_name().c_str(), value);
 
-  this->_last_update = millis();
+  this->markPending();
   publish_state(value);
 }
 
@@ -41,7 +41,7 @@ void OPTOLINKNumber::decode(uint8_t* data, uint8_t length, Datapoint* dp) {
   if (!dp) dp = this;
   
   if (_length == 1){         // Commonly percentage with factor /2
-    value = (float) data[0];
+    value = (float) (_mask ? (data[0] & _mask) >> getShift() : data[0]);
   }
   else if (_length == 2){   // Commonly temperature with factor /10 or /100
     int16_t tmp = 0;
@@ -60,11 +60,16 @@ void OPTOLINKNumber::decode(uint8_t* data, uint8_t length, Datapoint* dp) {
 
   ESP_LOGD(TAG, "decode called with data: %f", value);
   value = value / this->_div_ratio;
-  ESP_LOGD(TAG, "decode after div_ratio %d: %f", this->_div_ratio, value);
+  ESP_LOGD(TAG, "decode after div_ratio %zu: %f", this->_div_ratio, value);
 
   publish_state(value);
 }
 
+void OPTOLINKNumber::invalidate() {
+  ESP_LOGD(TAG, "Value of number %s is outdated", this->get_name().c_str());
+  publish_state(NAN);
+}
+
 void OPTOLINKNumber::encode(uint8_t* raw, uint8_t length) {
   float value = this->state;
   encode(raw, length, value);
@@ -83,7 +88,8 @@ void OPTOLINKNumber::encode(uint8_t* raw, uint8_t length, float data) {
 
   if(_length == 1) {
     uint8_t tmp = (uint8_t)(floor((value) + 0.5));
-    raw[0] = tmp;
+    // only the masked bits are set, the hub merges them into the current byte
+    raw[0] = _mask ? (tmp << getShift()) & _mask : tmp;
   }
   // Commonly temperature with factor /10 or /100
   else if (_length == 2){
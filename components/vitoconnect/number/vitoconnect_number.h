@@ -20,6 +20,8 @@ class OPTOLINKNumber : public number::Number, public Datapoint {
     void encode(uint8_t* raw, uint8_t length, float data);
     void encode(uint8_t* raw, uint8_t length) override;
 
+    void invalidate() override;
+
     void setDivRatio(size_t div) { this->_div_ratio = div; }
   private:
     size_t _div_ratio = 1;
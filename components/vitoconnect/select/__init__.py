@@ -0,0 +1,52 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import select
+from esphome.const import CONF_ID, CONF_ADDRESS, CONF_OPTIONS
+from .. import vitoconnect_ns, Datapoint, DATAPOINT_SCHEMA, register_datapoint
+
+DEPENDENCIES = ["vitoconnect"]
+OPTOLINKSelect = vitoconnect_ns.class_("OPTOLINKSelect", select.Select, Datapoint)
+
+
+def validate_options(value):
+    value = cv.Schema({cv.string: cv.uint8_t})(value)
+    if not value:
+        raise cv.Invalid("at least one option is required")
+    raws = list(value.values())
+    if len(set(raws)) != len(raws):
+        raise cv.Invalid("raw values of the options must be unique")
+    return value
+
+
+CONFIG_SCHEMA = select.select_schema(OPTOLINKSelect).extend({
+    cv.GenerateID(): cv.declare_id(OPTOLINKSelect),
+    cv.Required(CONF_ADDRESS): cv.uint16_t,
+    cv.Required(CONF_OPTIONS): validate_options,
+}).extend(DATAPOINT_SCHEMA)
+
+async def to_code(config):
+    options = config[CONF_OPTIONS]
+    var = await select.new_select(
+        config,
+        options=list(options.keys()),
+    )
+
+    # Lookup tables in flash: option index -> raw value and raw value -> option index
+    raws = list(options.values())
+    index = [0xFF] * (max(raws) + 1)
+    for i, raw in enumerate(raws):
+        index[raw] = i
+    raw_table = cg.static_const_array(
+        cg.ID(f"{config[CONF_ID].id}_raw", is_declaration=True, type=cg.uint8), raws
+    )
+    index_table = cg.static_const_array(
+        cg.ID(f"{config[CONF_ID].id}_index", is_declaration=True, type=cg.uint8), index
+    )
+
+    # Add configuration to datapoint
+    cg.add(var.setAddress(config[CONF_ADDRESS]))
+    cg.add(var.setLength(1))
+    cg.add(var.set_tables(raw_table, index_table, len(index)))
+
+    # Add sensor to component hub (VitoConnect)
+    await register_datapoint(var, config)
@@ -0,0 +1,57 @@
+#include "vitoconnect_select.h"
+
+namespace esphome {
+namespace vitoconnect {
+
+static const char *TAG = "vitoconnect.select";
+
+OPTOLINKSelect::OPTOLINKSelect(){}
+
+OPTOLINKSelect::~OPTOLINKSelect() {}
+
+void OPTOLINKSelect::control(const std::string &value) {
+  auto index = this->index_of(value);
+  if (!index.has_value()) {
+    ESP_LOGE(TAG, "option %s of select %s unknown", value.c_str(), this->get_name().c_str());
+    return;
+  }
+  ESP_LOGI(TAG, "state of select %s to option %s", this->get_name().c_str(), value.c_str());
+  this->_selected = *index;
+  this->markPending();
+  publish_state(*index);
+}
+
+void OPTOLINKSelect::decode(uint8_t* data, uint8_t length, Datapoint* dp) {
+  assert(length == 1);
+  uint8_t index = data[0] < _indexSize ? _indexTable[data[0]] : 0xFF;
+  if (index == 0xFF) {
+    ESP_LOGW(TAG, "raw value %d of select %s has no option", data[0], this->get_name().c_str());
+    return;
+  }
+  this->_selected = index;
+  publish_state((size_t) index);  // by index, the options are neither copied nor searched
+}
+
+void OPTOLINKSelect::invalidate() {
+  ESP_LOGD(TAG, "Value of select %s is outdated", this->get_name().c_str());
+  // notify the frontends without a state, the API reports it as missing (unknown)
+  this->set_has_state(false);
+  this->state_callback_.call(this->state, _selected);
+}
+
+void OPTOLINKSelect::encode(uint8_t* raw, uint8_t length) {
+  encode(raw, length, _selected);
+}
+
+void OPTOLINKSelect::encode(uint8_t* raw, uint8_t length, void* data) {
+  size_t index = *reinterpret_cast<size_t*>(data);
+  encode(raw, length, index);
+}
+
+void OPTOLINKSelect::encode(uint8_t* raw, uint8_t length, size_t index) {
+  assert(length == 1);
+  raw[0] = _rawTable[index];
+}
+
+}  // namespace vitoconnect
+}  // namespace esphome
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "esphome/components/select/select.h"
+#include "../vitoconnect_datapoint.h"
+
+namespace esphome {
+namespace vitoconnect {
+
+class OPTOLINKSelect : public select::Select, public Datapoint {
+
+  public:
+    OPTOLINKSelect();
+    ~OPTOLINKSelect();
+
+    /**
+     * @brief Lookup tables generated into flash: raw value of each option
+     *        and option index of each raw value (0xFF for unknown values).
+     */
+    void set_tables(const uint8_t* raw, const uint8_t* index, uint16_t index_size) {
+      this->_rawTable = raw;
+      this->_indexTable = index;
+      this->_indexSize = index_size;
+    }
+
+    void decode(uint8_t* data, uint8_t length, Datapoint* dp = nullptr) override;
+    void encode(uint8_t* raw, uint8_t length, void* data) override;
+    void encode(uint8_t* raw, uint8_t length, size_t index);
+    void encode(uint8_t* raw, uint8_t length) override;
+    void invalidate() override;
+
+  protected:
+    void control(const std::string &value) override;
+
+    const uint8_t* _rawTable = nullptr;
+    const uint8_t* _indexTable = nullptr;
+    uint16_t _indexSize = 0;
+    size_t _selected = 0;
+
+};
+
+}  // namespace vitoconnect
+}  // namespace esphome
\ No newline at end of file
@@ -1,26 +1,54 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import sensor
-from esphome.const import CONF_ID, CONF_NAME, CONF_ADDRESS, CONF_LENGTH #, CONF_TYPE 
-from .. import vitoconnect_ns, VitoConnect, CONF_VITOCONNECT_ID
+from esphome.const import CONF_ID, CONF_NAME, CONF_ADDRESS, CONF_LENGTH, CONF_LAMBDA, CONF_TYPE
+from .. import vitoconnect_ns, VitoConnect, Datapoint, DatapointListener, DATAPOINT_SCHEMA, register_datapoint, CONF_VITOCONNECT_ID
 
 DEPENDENCIES = ["vitoconnect"]
-OPTOLINKSensor = vitoconnect_ns.class_("OPTOLINKSensor", sensor.Sensor)
+OPTOLINKSensor = vitoconnect_ns.class_("OPTOLINKSensor", sensor.Sensor, Datapoint)
+OPTOLINKDerivedSensor = vitoconnect_ns.class_("OPTOLINKDerivedSensor", sensor.Sensor, DatapointListener)
 
-CONFIG_SCHEMA = sensor.sensor_schema(OPTOLINKSensor).extend({
-    cv.GenerateID(): cv.declare_id(OPTOLINKSensor),
-    cv.GenerateID(CONF_VITOCONNECT_ID): cv.use_id(VitoConnect),
-    cv.Required(CONF_ADDRESS): cv.uint16_t,
-    cv.Required(CONF_LENGTH): cv.uint8_t,
-})
+CONF_INPUTS = "inputs"
+
+TYPE_DATAPOINT = "datapoint"
+TYPE_DERIVED = "derived"
+
+CONFIG_SCHEMA = cv.typed_schema(
+    {
+        TYPE_DATAPOINT: sensor.sensor_schema(OPTOLINKSensor).extend({
+            cv.GenerateID(): cv.declare_id(OPTOLINKSensor),
+            cv.Required(CONF_ADDRESS): cv.uint16_t,
+            cv.Required(CONF_LENGTH): cv.uint8_t,
+        }).extend(DATAPOINT_SCHEMA),
+        TYPE_DERIVED: sensor.sensor_schema(OPTOLINKDerivedSensor).extend({
+            cv.GenerateID(): cv.declare_id(OPTOLINKDerivedSensor),
+            cv.GenerateID(CONF_VITOCONNECT_ID): cv.use_id(VitoConnect),
+            cv.Required(CONF_INPUTS): cv.ensure_list(cv.use_id(Datapoint)),
+            cv.Required(CONF_LAMBDA): cv.returning_lambda,
+        }),
+    },
+    default_type=TYPE_DATAPOINT,
+)
 
 async def to_code(config):
     var = await sensor.new_sensor(config)
 
+    if config[CONF_TYPE] == TYPE_DERIVED:
+        hub = await cg.get_variable(config[CONF_VITOCONNECT_ID])
+        template_ = await cg.process_lambda(
+            config[CONF_LAMBDA], [], return_type=cg.optional.template(float)
+        )
+        cg.add(var.set_template(template_))
+
+        # Recompute whenever the raw value of one of the inputs changes
+        for input_id in config[CONF_INPUTS]:
+            dp = await cg.get_variable(input_id)
+            cg.add(hub.register_listener(var, dp))
+        return
+
     # Add configuration to datapoint
     cg.add(var.setAddress(config[CONF_ADDRESS]))
     cg.add(var.setLength(config[CONF_LENGTH]))
 
     # Add sensor to component hub (VitoConnect)
-    hub = await cg.get_variable(config[CONF_VITOCONNECT_ID])
-    cg.add(hub.register_datapoint(var))
+    await register_datapoint(var, config)
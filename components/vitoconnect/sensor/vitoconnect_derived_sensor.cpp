@@ -0,0 +1,27 @@
+#include "vitoconnect_derived_sensor.h"
+
+namespace esphome {
+namespace vitoconnect {
+
+static const char *TAG = "vitoconnect.sensor";
+
+OPTOLINKDerivedSensor::OPTOLINKDerivedSensor(){
+  // empty
+}
+
+OPTOLINKDerivedSensor::~OPTOLINKDerivedSensor() {
+  // empty
+}
+
+void OPTOLINKDerivedSensor::onDatapointChanged() {
+  if (!this->_f) return;
+
+  optional<float> value = this->_f();
+  if (value.has_value()) {
+    ESP_LOGD(TAG, "Recomputed derived sensor %s: %f", this->get_name().c_str(), *value);
+    publish_state(*value);
+  }
+}
+
+}  // namespace vitoconnect
+}  // namespace esphome
\ No newline at end of file
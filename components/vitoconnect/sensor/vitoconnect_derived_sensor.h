@@ -0,0 +1,30 @@
+#pragma once
+
+#include "esphome/components/sensor/sensor.h"
+#include "../vitoconnect_datapoint.h"
+
+namespace esphome {
+namespace vitoconnect {
+
+/**
+ * @brief Sensor computed from the values of other datapoints (eg. delta-T).
+ *
+ * The value is only recomputed when the raw bytes of one of its inputs
+ * changed, hence it does not cause any additional traffic on the optolink.
+ */
+class OPTOLINKDerivedSensor : public sensor::Sensor, public DatapointListener {
+
+  public:
+    OPTOLINKDerivedSensor();
+    ~OPTOLINKDerivedSensor();
+
+    void set_template(std::function<optional<float>()> &&f) { this->_f = f; }
+
+    void onDatapointChanged() override;
+
+  private:
+    std::function<optional<float>()> _f;
+};
+
+}  // namespace vitoconnect
+}  // namespace esphome
\ No newline at end of file
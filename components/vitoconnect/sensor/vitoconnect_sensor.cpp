@@ -36,6 +36,11 @@ void OPTOLINKSensor::decode(uint8_t* data, uint8_t length, Datapoint* dp) {
   }
 }
 
+void OPTOLINKSensor::invalidate() {
+  ESP_LOGD(TAG, "Value of sensor %s is outdated", this->get_name().c_str());
+  publish_state(NAN);
+}
+
 void OPTOLINKSensor::encode(uint8_t* raw, uint8_t length, void* data) {
   float value = *reinterpret_cast<float*>(data);
   encode(raw, length, value);
@@ -16,6 +16,8 @@ class OPTOLINKSensor : public sensor::Sensor, public Datapoint {
     void encode(uint8_t* raw, uint8_t length, void* data) override;
     void encode(uint8_t* raw, uint8_t length, float data);
 
+    void invalidate() override;
+
 };
 
 }  // namespace vitoconnect
@@ -2,16 +2,17 @@ import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import switch
 from esphome.const import CONF_ADDRESS
-from .. import vitoconnect_ns, VitoConnect, CONF_VITOCONNECT_ID
+from .. import vitoconnect_ns, Datapoint, DATAPOINT_SCHEMA, register_datapoint
 
 DEPENDENCIES = ["vitoconnect"]
-OPTOLINKSwitch = vitoconnect_ns.class_("OPTOLINKSwitch", switch.Switch)
+CONF_BIT = "bit"
+OPTOLINKSwitch = vitoconnect_ns.class_("OPTOLINKSwitch", switch.Switch, Datapoint)
 
 CONFIG_SCHEMA = switch.switch_schema(OPTOLINKSwitch).extend({
     cv.GenerateID(): cv.declare_id(OPTOLINKSwitch),
-    cv.GenerateID(CONF_VITOCONNECT_ID): cv.use_id(VitoConnect),
     cv.Required(CONF_ADDRESS): cv.uint16_t,
-})
+    cv.Optional(CONF_BIT): cv.int_range(min=0, max=7),
+}).extend(DATAPOINT_SCHEMA)
 
 async def to_code(config):
     var = await switch.new_switch(
@@ -21,7 +22,8 @@ async def to_code(config):
     # Add configuration to datapoint
     cg.add(var.setAddress(config[CONF_ADDRESS]))
     cg.add(var.setLength(1))
+    if CONF_BIT in config:
+        cg.add(var.setMask(1 << config[CONF_BIT]))
 
     # Add sensor to component hub (VitoConnect)
-    hub = await cg.get_variable(config[CONF_VITOCONNECT_ID])
-    cg.add(hub.register_datapoint(var))
+    await register_datapoint(var, config)
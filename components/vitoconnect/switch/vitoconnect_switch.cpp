@@ -14,14 +14,21 @@ void OPTOLINKSwitch::write_state(bool value) {
     ESP_LOGE(TAG, "control value of switch %s not 0 or 1", this->get_name().c_str());
   } else {
     ESP_LOGI(TAG, "state of switch %s to value %d", this->get_name().c_str(), value);
-    this->_last_update = millis();
+    this->markPending();
     publish_state(value);
   }
 }
 
 void OPTOLINKSwitch::decode(uint8_t* data, uint8_t length, Datapoint* dp) {
   assert(length == 1);
-  publish_state(data[0] != 0);
+  publish_state((_mask ? data[0] & _mask : data[0]) != 0);
+}
+
+void OPTOLINKSwitch::invalidate() {
+  ESP_LOGD(TAG, "State of switch %s is outdated", this->get_name().c_str());
+  // notify the frontends without a state, the next read publishes it again
+  this->set_has_state(false);
+  this->state_callback_.call(this->state);
 }
 
 void OPTOLINKSwitch::encode(uint8_t* raw, uint8_t length) {
@@ -36,7 +43,11 @@ void OPTOLINKSwitch::encode(uint8_t* raw, uint8_t length, void* data) {
 
 void OPTOLINKSwitch::encode(uint8_t* raw, uint8_t length, bool data) {
   assert(length == 1);
-  raw[0] = data ? 1 : 0;
+  if (_mask) {
+    raw[0] = data ? _mask : 0;  // merged into the current byte by the hub
+  } else {
+    raw[0] = data ? 1 : 0;
+  }
 }
 
 }  // namespace vitoconnect
@@ -18,6 +18,7 @@ class OPTOLINKSwitch : public switch_::Switch, public Datapoint {
     void encode(uint8_t* raw, uint8_t length, void* data) override;
     void encode(uint8_t* raw, uint8_t length, bool data);
     void encode(uint8_t* raw, uint8_t length) override;
+    void invalidate() override;
 
 };
 
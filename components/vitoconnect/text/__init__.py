@@ -0,0 +1,50 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import text
+from esphome.const import CONF_ADDRESS
+from .. import vitoconnect_ns, Datapoint, DatapointGroup, DATAPOINT_SCHEMA, CONF_GROUP, CONF_VITOCONNECT_ID, register_datapoint
+
+DEPENDENCIES = ["vitoconnect"]
+OPTOLINKScheduleDay = vitoconnect_ns.class_("OPTOLINKScheduleDay", text.Text, Datapoint)
+
+CONF_SCHEDULE_GROUP_ID = "schedule_group_id"
+DAYS = ["monday", "tuesday", "wednesday", "thursday", "friday", "saturday", "sunday"]
+DAY_LENGTH = 8
+
+DAY_SCHEMA = text.text_schema(OPTOLINKScheduleDay).extend({
+    cv.GenerateID(): cv.declare_id(OPTOLINKScheduleDay),
+}).extend(DATAPOINT_SCHEMA)
+
+# One entry covers a week of 8-byte day blocks starting at address (monday)
+CONFIG_SCHEMA = cv.All(
+    cv.Schema({
+        cv.GenerateID(CONF_SCHEDULE_GROUP_ID): cv.declare_id(DatapointGroup),
+        cv.Required(CONF_ADDRESS): cv.uint16_t,
+        **{cv.Optional(day): DAY_SCHEMA for day in DAYS},
+    }),
+    cv.has_at_least_one_key(*DAYS),
+)
+
+async def to_code(config):
+    # read the days of the week back-to-back as block reads
+    group = cg.new_Pvariable(config[CONF_SCHEDULE_GROUP_ID])
+    hub = None
+
+    for i, day in enumerate(DAYS):
+        if day not in config:
+            continue
+        day_config = config[day]
+        var = await text.new_text(day_config, max_length=47)
+
+        # Add configuration to datapoint
+        cg.add(var.setAddress(config[CONF_ADDRESS] + i * DAY_LENGTH))
+        cg.add(var.setLength(DAY_LENGTH))
+        if CONF_GROUP not in day_config:
+            cg.add(group.add_datapoint(var))
+
+        # Add sensor to component hub (VitoConnect)
+        await register_datapoint(var, day_config)
+        if hub is None:
+            hub = await cg.get_variable(day_config[CONF_VITOCONNECT_ID])
+
+    cg.add(hub.register_group(group))
@@ -0,0 +1,92 @@
+#include "vitoconnect_schedule.h"
+
+namespace esphome {
+namespace vitoconnect {
+
+static const char *TAG = "vitoconnect.schedule";
+
+OPTOLINKScheduleDay::OPTOLINKScheduleDay() {
+  memset(_times, 0xFF, sizeof(_times));
+  _text.reserve(48);
+}
+
+OPTOLINKScheduleDay::~OPTOLINKScheduleDay() {}
+
+void OPTOLINKScheduleDay::control(const std::string &value) {
+  uint8_t times[8];
+  if (!parse(value, times)) {
+    ESP_LOGE(TAG, "schedule \"%s\" of %s invalid, expected hh:mm-hh:mm pairs in steps of 10 minutes, off not before on", value.c_str(), this->get_name().c_str());
+    return;
+  }
+  ESP_LOGI(TAG, "schedule of %s to %s", this->get_name().c_str(), value.c_str());
+  memcpy(_times, times, sizeof(_times));
+  this->markPending();
+  _format(_times);
+  publish_state(_text);
+}
+
+bool OPTOLINKScheduleDay::parse(const std::string &value, uint8_t* raw) {
+  memset(raw, 0xFF, 8);
+  const char* p = value.c_str();
+  for (uint8_t i = 0; i < 8; ++i) {
+    while (*p == ' ') ++p;
+    if (*p == '\0') return i % 2 == 0;
+
+    unsigned hour, minute;
+    int n = 0;
+    if (sscanf(p, "%2u:%2u%n", &hour, &minute, &n) != 2 || hour > 24 || minute > 50 || minute % 10 != 0 || (hour == 24 && minute != 0)) {
+      return false;
+    }
+    raw[i] = hour << 3 | minute / 10;
+    p += n;
+
+    // the encoding is monotonic, so the raw bytes compare like the times
+    if (i % 2 == 1 && raw[i] < raw[i - 1]) return false;
+
+    // on and off time are separated by a dash
+    if (i % 2 == 0) {
+      if (*p != '-') return false;
+      ++p;
+    }
+  }
+  while (*p == ' ') ++p;
+  return *p == '\0';
+}
+
+void OPTOLINKScheduleDay::_format(const uint8_t* raw) {
+  char buffer[13];
+  _text.clear();
+  // stop at the first unused on or off time, a pair without off time is not switched
+  for (uint8_t i = 0; i < 8 && raw[i] != 0xFF && raw[i + 1] != 0xFF; i += 2) {
+    snprintf(buffer, sizeof(buffer), "%s%02d:%02d-%02d:%02d", i == 0 ? "" : " ",
+             raw[i] >> 3, (raw[i] & 0x07) * 10, raw[i + 1] >> 3, (raw[i + 1] & 0x07) * 10);
+    _text.append(buffer);
+  }
+}
+
+void OPTOLINKScheduleDay::decode(uint8_t* data, uint8_t length, Datapoint* dp) {
+  assert(length >= 8);
+  memcpy(_times, data, sizeof(_times));
+  _format(_times);
+  ESP_LOGD(TAG, "decode called with data: %s", _text.c_str());
+  publish_state(_text);
+}
+
+void OPTOLINKScheduleDay::invalidate() {
+  ESP_LOGD(TAG, "Schedule of %s is outdated", this->get_name().c_str());
+  // notify the frontends without a state, the API reports it as missing (unknown)
+  this->set_has_state(false);
+  this->state_callback_.call(this->state);
+}
+
+void OPTOLINKScheduleDay::encode(uint8_t* raw, uint8_t length) {
+  encode(raw, length, _times);
+}
+
+void OPTOLINKScheduleDay::encode(uint8_t* raw, uint8_t length, void* data) {
+  assert(length == 8);
+  memcpy(raw, data, 8);
+}
+
+}  // namespace vitoconnect
+}  // namespace esphome
\ No newline at end of file
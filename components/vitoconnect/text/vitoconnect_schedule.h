@@ -0,0 +1,38 @@
+#pragma once
+
+#include "esphome/components/text/text.h"
+#include "../vitoconnect_datapoint.h"
+
+namespace esphome {
+namespace vitoconnect {
+
+/**
+ * @brief Switching times of one weekday (8 bytes, up to 4 on/off pairs).
+ *
+ * Each byte holds a time as hour << 3 | minutes / 10, unused slots are 0xFF.
+ * The text representation is "hh:mm-hh:mm hh:mm-hh:mm ...".
+ */
+class OPTOLINKScheduleDay : public text::Text, public Datapoint {
+
+  public:
+    OPTOLINKScheduleDay();
+    ~OPTOLINKScheduleDay();
+
+    void decode(uint8_t* data, uint8_t length, Datapoint* dp = nullptr) override;
+    void encode(uint8_t* raw, uint8_t length, void* data) override;
+    void encode(uint8_t* raw, uint8_t length) override;
+    void invalidate() override;
+
+    static bool parse(const std::string &value, uint8_t* raw);
+
+  protected:
+    void control(const std::string &value) override;
+    void _format(const uint8_t* raw);
+
+    uint8_t _times[8];
+    std::string _text;  // reused formatting buffer
+
+};
+
+}  // namespace vitoconnect
+}  // namespace esphome
\ No newline at end of file
@@ -0,0 +1,61 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import text_sensor
+from esphome.const import CONF_ID, CONF_ADDRESS, CONF_LENGTH
+from .. import vitoconnect_ns, Datapoint, DATAPOINT_SCHEMA, register_datapoint
+
+DEPENDENCIES = ["vitoconnect"]
+OPTOLINKTextSensor = vitoconnect_ns.class_("OPTOLINKTextSensor", text_sensor.TextSensor, Datapoint)
+TextCodec = vitoconnect_ns.enum("TextCodec")
+
+CONF_CODEC = "codec"
+CONF_CODES = "codes"
+
+TEXT_CODECS = {
+    "code": TextCodec.TEXT_CODE,
+    "hex": TextCodec.TEXT_HEX,
+    "bcd_date": TextCodec.TEXT_BCD_DATE,
+}
+
+CONFIG_SCHEMA = text_sensor.text_sensor_schema(OPTOLINKTextSensor).extend({
+    cv.GenerateID(): cv.declare_id(OPTOLINKTextSensor),
+    cv.Required(CONF_ADDRESS): cv.uint16_t,
+    cv.Required(CONF_LENGTH): cv.int_range(min=1, max=9),
+    cv.Optional(CONF_CODEC, default="hex"): cv.enum(TEXT_CODECS, lower=True),
+    cv.Optional(CONF_CODES): cv.Schema({cv.uint8_t: cv.string}),
+}).extend(DATAPOINT_SCHEMA)
+
+def validate_codec(config):
+    if config[CONF_CODEC] == "code" and not config.get(CONF_CODES):
+        raise cv.Invalid("codec 'code' requires a table of codes")
+    if config[CONF_CODEC] == "bcd_date" and config[CONF_LENGTH] != 8:
+        raise cv.Invalid("codec 'bcd_date' requires a length of 8")
+    return config
+
+CONFIG_SCHEMA = cv.All(CONFIG_SCHEMA, validate_codec)
+
+async def to_code(config):
+    var = await text_sensor.new_text_sensor(config)
+
+    # Add configuration to datapoint
+    cg.add(var.setAddress(config[CONF_ADDRESS]))
+    cg.add(var.setLength(config[CONF_LENGTH]))
+    cg.add(var.set_codec(config[CONF_CODEC]))
+
+    # Code table in flash: code -> index of its text, 0xFF for unknown codes
+    if CONF_CODES in config:
+        codes = config[CONF_CODES]
+        index = [0xFF] * (max(codes.keys()) + 1)
+        for i, code in enumerate(codes.keys()):
+            index[code] = i
+        index_table = cg.static_const_array(
+            cg.ID(f"{config[CONF_ID].id}_index", is_declaration=True, type=cg.uint8), index
+        )
+        texts_table = cg.static_const_array(
+            cg.ID(f"{config[CONF_ID].id}_texts", is_declaration=True, type=cg.global_ns.namespace("char *const")),
+            list(codes.values()),
+        )
+        cg.add(var.set_code_table(index_table, len(index), texts_table))
+
+    # Add sensor to component hub (VitoConnect)
+    await register_datapoint(var, config)
@@ -0,0 +1,74 @@
+#include "vitoconnect_text_sensor.h"
+
+namespace esphome {
+namespace vitoconnect {
+
+static const char *TAG = "vitoconnect.text_sensor";
+
+OPTOLINKTextSensor::OPTOLINKTextSensor() {
+  _text.reserve(3 * MAX_DP_LENGTH);
+}
+
+OPTOLINKTextSensor::~OPTOLINKTextSensor() {}
+
+void OPTOLINKTextSensor::decode(uint8_t* data, uint8_t length, Datapoint* dp) {
+  assert(length >= _length);
+
+  // formatting is only done once the raw bytes change
+  if (_hasPublished && memcmp(_published, data, _length) == 0) {
+    return;
+  }
+
+  char buffer[4];
+  _text.clear();
+  switch (_codec) {
+    case TEXT_CODE: {
+      uint8_t index = data[0] < _codeIndexSize ? _codeIndex[data[0]] : 0xFF;
+      if (index != 0xFF) {
+        _text.append(_codeTexts[index]);
+      } else {
+        snprintf(buffer, sizeof(buffer), "%02X", data[0]);
+        _text.append(buffer);
+      }
+      if (_length == 9) {
+        _text.append(" ");
+        _appendDate(&data[1]);
+      }
+      break;
+    }
+    case TEXT_BCD_DATE:
+      _appendDate(data);
+      break;
+    case TEXT_HEX:
+    default:
+      for (uint8_t i = 0; i < _length; ++i) {
+        snprintf(buffer, sizeof(buffer), i == 0 ? "%02X" : " %02X", data[i]);
+        _text.append(buffer);
+      }
+      break;
+  }
+
+  ESP_LOGD(TAG, "decode called with data: %s", _text.c_str());
+  memcpy(_published, data, _length);
+  _hasPublished = true;
+  publish_state(_text);
+}
+
+void OPTOLINKTextSensor::_appendDate(const uint8_t* data) {
+  // YYYY-MM-DD hh:mm:ss, BCD digits are printed as hex, byte 4 is the weekday
+  char buffer[20];
+  snprintf(buffer, sizeof(buffer), "%02X%02X-%02X-%02X %02X:%02X:%02X",
+           data[0], data[1], data[2], data[3], data[5], data[6], data[7]);
+  _text.append(buffer);
+}
+
+void OPTOLINKTextSensor::invalidate() {
+  ESP_LOGD(TAG, "Value of text sensor %s is outdated", this->get_name().c_str());
+  _hasPublished = false;
+  // notify the frontends without a state, the API reports it as missing (unknown)
+  this->set_has_state(false);
+  this->callback_.call(this->state);
+}
+
+}  // namespace vitoconnect
+}  // namespace esphome
\ No newline at end of file
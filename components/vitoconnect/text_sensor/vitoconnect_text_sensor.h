@@ -0,0 +1,51 @@
+#pragma once
+
+#include "esphome/components/text_sensor/text_sensor.h"
+#include "../vitoconnect_datapoint.h"
+#include "../vitoconnect_optolink.h"
+
+namespace esphome {
+namespace vitoconnect {
+
+enum TextCodec : uint8_t {
+  TEXT_CODE,      ///< Text of the first byte from the code table, date appended for error history entries (9 bytes)
+  TEXT_HEX,       ///< Hex dump of all bytes
+  TEXT_BCD_DATE   ///< BCD encoded system time (8 bytes)
+};
+
+class OPTOLINKTextSensor : public text_sensor::TextSensor, public Datapoint {
+
+  public:
+    OPTOLINKTextSensor();
+    ~OPTOLINKTextSensor();
+
+    void set_codec(TextCodec codec) { this->_codec = codec; }
+
+    /**
+     * @brief Code table generated into flash: index of each code into the
+     *        texts (0xFF for unknown codes) and the texts themselves.
+     */
+    void set_code_table(const uint8_t* index, uint16_t index_size, const char* const* texts) {
+      this->_codeIndex = index;
+      this->_codeIndexSize = index_size;
+      this->_codeTexts = texts;
+    }
+
+    void decode(uint8_t* data, uint8_t length, Datapoint* dp = nullptr) override;
+    void invalidate() override;
+
+  protected:
+    void _appendDate(const uint8_t* data);
+
+    TextCodec _codec = TEXT_HEX;
+    const uint8_t* _codeIndex = nullptr;
+    uint16_t _codeIndexSize = 0;
+    const char* const* _codeTexts = nullptr;
+    std::string _text;                  // reused formatting buffer
+    uint8_t _published[MAX_DP_LENGTH];  // raw bytes of the published text
+    bool _hasPublished = false;
+
+};
+
+}  // namespace vitoconnect
+}  // namespace esphome
\ No newline at end of file
@@ -19,6 +19,9 @@
 
 #include "vitoconnect.h"
 
+#include <algorithm>
+#include <cinttypes>
+
 namespace esphome {
 namespace vitoconnect {
 
@@ -39,12 +42,31 @@ void VitoConnect::setup() {
 
     // optimize datapoint list
     _datapoints.shrink_to_fit();
+    for (Datapoint* dp : _datapoints) {
+      dp->setClock(_clock);
+    }
+
+    // staged values waiting for their publish, each datapoint is staged at most once
+    _ready.reserve(_datapoints.size());
+
+    // share the schedule with other hubs on this device
+    _hubIndex = Coordinator::instance()->registerHub(this);
+
+    // merge group members into block reads
+    for (DatapointGroup* group : _groups) {
+      group->buildBlocks();
+    }
 
     if (_optolink) {
 
+      _optolink->setClock(_clock);
+
       // add onData and onError callbacks
       _optolink->onData(&VitoConnect::_onData);
       _optolink->onError(&VitoConnect::_onError);
+      if (_trace) {
+        _optolink->onTrace(&VitoConnect::_onTrace, this);
+      }
       
       // set initial state
       _optolink->begin();
@@ -59,89 +81,620 @@ void VitoConnect::register_datapoint(Datapoint *datapoint) {
     this->_datapoints.push_back(datapoint);
 }
 
+void VitoConnect::register_listener(DatapointListener *listener, Datapoint *datapoint) {
+    ESP_LOGD(TAG, "Adding listener to datapoint with address %x", datapoint->getAddress());
+    datapoint->addListener(listener);
+}
+
+void VitoConnect::register_group(DatapointGroup *group) {
+    this->_groups.push_back(group);
+}
+
 void VitoConnect::loop() {
+    Coordinator* coordinator = Coordinator::instance();
+    coordinator->beginLoop(this);
+
+    // start a polling cycle whose phase was offset against the other hubs
+    if (_pollScheduled && (int32_t) (_clock->now() - _pollAt) >= 0) {
+      _pollScheduled = false;
+      _poll();
+    }
+
     _optolink->loop();
+
+    // publish staged values within the budget of this loop pass
+    while (_ready.size() > 0 && coordinator->consumeBudget()) {
+      uint32_t start = _clock->micros();
+      Datapoint* dp = *_ready.front();
+      _ready.pop();
+      dp->setStaged(false);
+      if (dp->getLastUpdate() == 0) {  // do not overwrite a write that became pending meanwhile
+        dp->decodeRaw();
+      }
+      coordinator->addPublishTime(_clock->micros() - start);
+    }
+
+    // publish completed groups as a whole
+    for (DatapointGroup* group : _groups) {
+      if (group->isComplete() && coordinator->consumeBudget(group->getReadyCount())) {
+        uint32_t start = _clock->micros();
+        group->publish();
+        coordinator->addPublishTime(_clock->micros() - start);
+      }
+    }
+
+    // recompute listeners once the polling cycle is done: no request queued,
+    // no value staged and no group waiting to be published
+    bool cycleDone = _optolink->queueSize() == 0 && _ready.size() == 0;
+    for (DatapointGroup* group : _groups) {
+      cycleDone &= !group->isReading();
+    }
+    if (!_changedListeners.empty() && cycleDone) {
+      auto it = _changedListeners.begin();
+      while (it != _changedListeners.end() && coordinator->consumeBudget()) {
+        uint32_t start = _clock->micros();
+        (*it)->onDatapointChanged();
+        coordinator->addPublishTime(_clock->micros() - start);
+        ++it;
+      }
+      _changedListeners.erase(_changedListeners.begin(), it);
+    }
 }
 
 void VitoConnect::update() {
   // This will be called every "update_interval" milliseconds.
+  if (_hubIndex == 0) {
+    Coordinator::instance()->logStatistics();
+  }
+
+  // the heap minimum is tracked every cycle, the report is opt-in and rate limited
+  _diagnostics.sampleHeap();
+  if (_diagnosticsInterval != 0 && _clock->now() - _lastDiagnostics >= _diagnosticsInterval) {
+    _lastDiagnostics = _clock->now();
+    logDiagnostics();
+  }
+
+  // offset the polling phase against the other hubs
+  uint32_t offset = Coordinator::instance()->getPhaseOffset(_hubIndex, this->get_update_interval());
+  if (offset > 0) {
+    // timed by the hub clock rather than the scheduler, so a virtual clock drives it too
+    _pollAt = _clock->now() + offset;
+    _pollScheduled = true;
+  } else {
+    _poll();
+  }
+}
+
+void VitoConnect::logDiagnostics() {
+  _diagnostics.log(_hubIndex, _answerCount, _errorCount, _optolink ? _optolink->getQueueHighWater() : 0, _publishHighWater);
+}
+
+void VitoConnect::_poll() {
   ESP_LOGD(TAG, "Schedule sensor update");
 
+  _checkStale();
+
+  // report the addresses that are currently quarantined
+  for (Datapoint* dp : this->_datapoints) {
+    if (dp->isQuarantined()) {
+      ESP_LOGD(TAG, "Datapoint with address %x is quarantined after %d failed reads.", dp->getAddress(), dp->getErrorCount());
+    }
+  }
+
+  // wait until the previous transaction has been verified
+  if (_transaction != nullptr) {
+    ESP_LOGD(TAG, "Write transaction still in progress, skip polling cycle.");
+    return;
+  }
+
   // prioritize writes over reads
   bool foundDirty = false;
+  Transaction* transaction = nullptr;
+  std::vector<uint16_t> merged;
+  // partial writes back off per datapoint, before their bits are merged
   for (Datapoint* dp : this->_datapoints) {
-    if(dp->getLastUpdate() != 0) {
-      foundDirty = true;
-      ESP_LOGD(TAG, "Datapoint with address %x was modified and needs to be written.", dp->getAddress());
-      
+    if (dp->getLastUpdate() != 0 && dp->getMask() != 0) dp->skipWrite();
+  }
+  for (Datapoint* dp : this->_datapoints) {
+    if (dp->getLastUpdate() != 0 && dp->getMask() != 0) {
+      // partial writes of the same byte are merged into a single write
+      if (dp->isWriteDeferred()) continue;
+      if (std::find(merged.begin(), merged.end(), dp->getAddress()) != merged.end()) continue;
+      merged.push_back(dp->getAddress());
+      foundDirty |= _writeMasked(dp->getAddress());
+    } else if(dp->getLastUpdate() != 0) {
+      if (dp->skipWrite()) {
+        ESP_LOGD(TAG, "Write of datapoint with address %x is backing off.", dp->getAddress());
+        continue;
+      }
       uint8_t* data = new uint8_t[dp->getLength()];
       dp->encode(data, dp->getLength());
 
-      // write the modified datapoint
-      CbArg* writeCbArg = new CbArg(this, dp, true, dp->getLastUpdate());        
-      if (!_optolink->write(dp->getAddress(), dp->getLength(), data, reinterpret_cast<void*>(writeCbArg))) {
-        delete writeCbArg;
-        delete[] data;  // Free the data buffer if write fails to queue
-        return;
-      }
-      
-      // read the same datapoint to verify the previous write
-      CbArg* readCbArg = new CbArg(this, dp, false, 0, data);
-      if (!_optolink->read(dp->getAddress(), dp->getLength(), reinterpret_cast<void*>(readCbArg))) {
-        delete readCbArg;
-        delete[] data;  // Free the data buffer if read fails to queue
-        return;
+      // skip the write if the device already holds the value (cache read within the last cycle)
+      const uint8_t* raw = dp->getRaw();
+      if (raw != nullptr && _clock->now() - dp->getLastRead() <= this->get_update_interval() && memcmp(raw, data, dp->getLength()) == 0) {
+        ESP_LOGD(TAG, "Datapoint with address %x already holds the value, skipping write.", dp->getAddress());
+        ++_skippedWrites;
+        dp->clearLastUpdate();
+        dp->writeCommitted();
+        delete[] data;
+        continue;
       }
+
+      ESP_LOGD(TAG, "Datapoint with address %x was modified and needs to be written.", dp->getAddress());
+      if (transaction == nullptr) transaction = new Transaction();
+      transaction->entries.push_back({dp, data, dp->getLastUpdate(), false});
     }
   }
-  
+
+  // all modified datapoints are written as one transaction
+  if (transaction != nullptr) {
+    foundDirty = true;
+    _commit(transaction);
+  }
+
   if(foundDirty) {
     ESP_LOGD(TAG, "Found dirty datapoint(s), skip polling cycle.");
     return;
   }
 
+  // read groups first so their members are read back-to-back
+  for (DatapointGroup* group : this->_groups) {
+    if (group->isReading()) {
+      ESP_LOGD(TAG, "Previous read of group is still in progress, skipping.");
+      continue;
+    }
+    if (group->getTimestamp() != 0 && _clock->now() - group->getTimestamp() < group->getPollInterval()) continue;
+    group->beginRead();
+    const std::vector<Datapoint*>& dps = group->getDatapoints();
+    for (const DatapointBlock& block : group->getBlocks()) {
+      // members that are backing off are left out, the others are read in runs
+      // of neighbours, so a rejected address does not fail the whole block
+      uint8_t end = block.first + block.count;
+      uint8_t runFirst = block.first;
+      for (uint8_t j = block.first; j <= end; ++j) {
+        if (j < end && !dps[j]->skipCycle()) continue;
+        if (j > runFirst) _readMembers(group, runFirst, j - runFirst);
+        runFirst = j + 1;
+      }
+    }
+  }
+
   for (Datapoint* dp : this->_datapoints) {
+      if (dp->getGroup() != nullptr) continue;
+      if (dp->isReading()) continue;  // a cycle slowed down by timeouts must not queue it twice
+      if (dp->skipCycle()) continue;
+      if (dp->getLastRead() != 0 && _clock->now() - dp->getLastRead() < dp->getPollInterval()) continue;
       CbArg* arg = new CbArg(this, dp, false, 0);
       if (_optolink->read(dp->getAddress(), dp->getLength(), reinterpret_cast<void*>(arg))) {
+          dp->setReading(true);
       } else {
           delete arg;
       }
   }
 }
 
+void VitoConnect::_checkStale() {
+  if (_staleFactor == 0) return;
+
+  // values are stale once they have not been read for stale_factor polling cycles
+  uint32_t now = _clock->now();
+  uint32_t maxAge = this->get_update_interval() * _staleFactor;
+  uint8_t staleCount = 0;
+  for (Datapoint* dp : this->_datapoints) {
+    uint32_t interval = dp->getGroup() ? dp->getGroup()->getPollInterval() : dp->getPollInterval();
+    if (now - dp->getLastRead() > std::max(maxAge, interval * _staleFactor)) {
+      if (!dp->isStale()) {
+        ESP_LOGW(TAG, "Datapoint with address %x has not been read for %" PRIu32 " s, marking it as stale.", dp->getAddress(), (now - dp->getLastRead()) / 1000);
+        dp->setStale();
+      }
+      ++staleCount;
+    }
+  }
+
+  if (staleCount > 0) {
+    this->status_set_warning();
+  } else {
+    this->status_clear_warning();
+  }
+}
+
+void VitoConnect::_readFailed(Datapoint* dp, uint8_t error) {
+  if (_quarantineAfter == 0) return;
+
+  // a timeout only counts against the address while the link itself is working
+  if (error == TIMEOUT && _clock->now() - _lastData > this->get_update_interval()) return;
+  if (error != TIMEOUT && error != VITO_ERROR) return;
+
+  // the count saturates, an address that never answers must not wrap back out of quarantine
+  uint8_t errors = std::min<uint16_t>(dp->getErrorCount() + 1, UINT8_MAX);
+  if (errors >= _quarantineAfter) {
+    if (!dp->isQuarantined()) {
+      ESP_LOGW(TAG, "Datapoint with address %x failed %d times in a row, quarantining it.", dp->getAddress(), errors);
+    }
+    uint32_t cycles = _reprobeInterval / std::max<uint32_t>(this->get_update_interval(), 1);
+    dp->readFailed(std::min<uint32_t>(cycles, UINT16_MAX), true);
+  } else {
+    // exponential backoff: skip 0, 1, 3, 7, ... polling cycles, saturating at UINT16_MAX
+    uint8_t exponent = std::min<uint8_t>(errors - 1, 16);
+    dp->readFailed((1UL << exponent) - 1, false);
+  }
+}
+
+void VitoConnect::_readSucceeded(Datapoint* dp) {
+  _lastData = _clock->now();
+  if (dp->readSucceeded()) {
+    ESP_LOGI(TAG, "Datapoint with address %x answered again, leaving quarantine.", dp->getAddress());
+  }
+}
+
 void VitoConnect::_onData(uint8_t* data, uint8_t len, void* arg) {
   CbArg* cbArg = reinterpret_cast<CbArg*>(arg);
+  cbArg->v->_diagnostics.latency(cbArg->v->_clock->now() - cbArg->ts);
+  ++cbArg->v->_answerCount;
+
+  if (cbArg->g != nullptr) {
+    cbArg->v->_onBlockData(cbArg, data, len);
+    delete cbArg;
+    return;
+  }
+
+  if (cbArg->m != 0) {
+    cbArg->v->_verifyMasked(cbArg, data, len);
+    delete cbArg;
+    return;
+  }
 
+  if (cbArg->r) {
+    // current byte of a partial write, update the cache of all datapoints sharing it
+    for (Datapoint* dp : cbArg->v->_datapoints) {
+      if (dp->getAddress() == cbArg->dp->getAddress() && dp->getMask() != 0) {
+        cbArg->v->_storeRaw(dp, data, len);
+        dp->setLastRead(cbArg->v->_clock->now());
+      }
+    }
+    if (len == 1) cbArg->v->_writeMasked(cbArg->dp->getAddress());
+    delete cbArg;
+    return;
+  }
+
+  if (cbArg->t != nullptr) {
+    cbArg->v->_onTransactionData(cbArg, data, len);
+    delete cbArg;
+    return;
+  }
+
+  bool publish = false;
   if (cbArg->dp->getLastUpdate() > 0) {
-    if (!cbArg->w && cbArg->d == nullptr) {
+    if (cbArg->w) { // this was a write operation
+      ESP_LOGD(TAG, "Write operation for datapoint with address %x has been completed.", cbArg->dp->getAddress());
+    } else {
       ESP_LOGD(TAG, "Datapoint with address %x is eventually being written, waiting for confirmation.", cbArg->dp->getAddress());
-    } else if (cbArg->w) { // this was a write operation
-      ESP_LOGD(TAG, "Write operation for datapoint with address %x %s.", 
-             cbArg->dp->getAddress(), data[0] == 0x00 ? "has been completed" : "failed");
-    } else if (cbArg->d != nullptr) { // cbArg->d is only set if this read is intended to verify a previous write
-      ESP_LOGD(TAG, "Verifying received data for datapoint with address %x.", cbArg->dp->getAddress());
-
-      if (len != cbArg->dp->getLength()) {
-        ESP_LOGW(TAG, "Expected length of %d was not met for datapoint with address %x.", cbArg->dp->getLength(), cbArg->dp->getAddress());
-      } else if (memcmp(data, cbArg->d, len) == 0) {
-        ESP_LOGD(TAG, "Previous write operation for datapoint with address %x was successfully verified.", cbArg->dp->getAddress());
-        cbArg->dp->clearLastUpdate();
-      } else {
-        ESP_LOGW(TAG, "Previous write operation for datapoint with address %x failed verification.", cbArg->dp->getAddress());
-      }
-      // Free the data buffer that was allocated for verification
-      delete[] cbArg->d;
     }
   } else if (!cbArg->w) {
-    cbArg->dp->decode(data, len, cbArg->dp);
+    publish = true;
+  }
+
+  if (!cbArg->w) {
+    cbArg->dp->setReading(false);
+    if (cbArg->v->_onDataCb) cbArg->v->_onDataCb(data, len, cbArg->dp);
+    cbArg->v->_readSucceeded(cbArg->dp);
+    cbArg->dp->setLastRead(cbArg->v->_clock->now());
+    cbArg->v->_storeRaw(cbArg->dp, data, len);
+    if (publish) {
+      cbArg->v->_stage(cbArg->dp);
+    }
   }
 
   delete cbArg;
 }
 
+bool VitoConnect::_writeMasked(uint16_t address) {
+  // collect the bits of all modified datapoints sharing this byte that are not backing off
+  Datapoint* first = nullptr;
+  uint8_t mask = 0;
+  uint8_t bits = 0;
+  for (Datapoint* dp : this->_datapoints) {
+    if (dp->getAddress() != address || dp->getMask() == 0 || dp->getLastUpdate() == 0) continue;
+    if (dp->isWriteDeferred()) continue;
+    if (first == nullptr) first = dp;
+    uint8_t raw = 0;
+    dp->encode(&raw, 1);
+    mask |= dp->getMask();
+    bits = (bits & ~dp->getMask()) | (raw & dp->getMask());
+  }
+  if (first == nullptr) return false;
+
+  // the remaining bits are taken from the cache if it was read within the last cycle
+  const uint8_t* cached = first->getRaw();
+  if (cached == nullptr || _clock->now() - first->getLastRead() > this->get_update_interval()) {
+    ESP_LOGD(TAG, "Reading byte at address %x before partial write.", address);
+    CbArg* arg = new CbArg(this, first, false, 0);
+    arg->r = true;
+    if (!_optolink->read(address, 1, reinterpret_cast<void*>(arg))) {
+      delete arg;
+    }
+    return true;
+  }
+
+  uint8_t value = (cached[0] & ~mask) | bits;
+  if (value == cached[0]) {
+    ESP_LOGD(TAG, "Byte at address %x already holds the bits, skipping write.", address);
+    for (Datapoint* dp : this->_datapoints) {
+      if (dp->getAddress() == address && (dp->getMask() & mask) != 0 && dp->getLastUpdate() != 0) {
+        ++_skippedWrites;
+        dp->clearLastUpdate();
+        dp->writeCommitted();
+      }
+    }
+    return false;
+  }
+
+  ESP_LOGD(TAG, "Writing bits %x of byte at address %x.", mask, address);
+  uint8_t* data = new uint8_t[1];
+  data[0] = value;
+  CbArg* writeCbArg = new CbArg(this, first, true, first->getLastUpdate());
+  if (!_optolink->write(address, 1, data, reinterpret_cast<void*>(writeCbArg))) {
+    delete writeCbArg;
+    delete[] data;
+    return true;
+  }
+
+  // read the byte to verify the bits of each merged datapoint
+  CbArg* readCbArg = new CbArg(this, first, false, 0, data);
+  readCbArg->m = mask;
+  if (!_optolink->read(address, 1, reinterpret_cast<void*>(readCbArg))) {
+    delete readCbArg;
+    delete[] data;
+  }
+  return true;
+}
+
+void VitoConnect::_verifyMasked(CbArg* cbArg, uint8_t* data, uint8_t len) {
+  uint16_t address = cbArg->dp->getAddress();
+  for (Datapoint* dp : this->_datapoints) {
+    if (dp->getAddress() != address || dp->getMask() == 0 || (dp->getMask() & cbArg->m) == 0) continue;
+    _storeRaw(dp, data, len);
+    dp->setLastRead(_clock->now());
+    if (dp->getLastUpdate() == 0) continue;
+    if (len == 1 && (data[0] & dp->getMask()) == (cbArg->d[0] & dp->getMask())) {
+      ESP_LOGD(TAG, "Partial write of address %x with mask %x was successfully verified.", address, dp->getMask());
+      dp->clearLastUpdate();
+      dp->writeCommitted();
+    } else {
+      ESP_LOGW(TAG, "Partial write of address %x with mask %x failed verification.", address, dp->getMask());
+      _writeFailed(dp);
+    }
+  }
+  delete[] cbArg->d;
+}
+
+void VitoConnect::_verifyMaskedFailed(CbArg* cbArg, uint8_t error) {
+  // the bits could not be verified, count it as a failed write of every merged datapoint
+  uint16_t address = cbArg->dp->getAddress();
+  for (Datapoint* dp : this->_datapoints) {
+    if (dp->getAddress() != address || (dp->getMask() & cbArg->m) == 0 || dp->getLastUpdate() == 0) continue;
+    dp->onError(error, dp);
+    if (_onErrorCb) _onErrorCb(error, dp);
+    _writeFailed(dp);
+  }
+  delete[] cbArg->d;
+}
+
+void VitoConnect::_commit(Transaction* t) {
+  // every write needs a second slot for its verification read
+  size_t needed = 2 * t->entries.size();
+  if (_optolink->queueAvailable() < needed) {
+    if (needed > _optolink->queueSize() + _optolink->queueAvailable()) {
+      ESP_LOGW(TAG, "Write transaction of %d datapoints exceeds the queue length.", (int) t->entries.size());
+      t->failAll();
+      _transaction = t;
+      _transactionDone(t);
+    } else {
+      ESP_LOGD(TAG, "Not enough room in queue for write transaction, retrying next cycle.");
+      for (TransactionEntry& entry : t->entries) delete[] entry.data;
+      delete t;
+    }
+    return;
+  }
+
+  ESP_LOGD(TAG, "Writing transaction of %d datapoint(s).", (int) t->entries.size());
+  _transaction = t;
+  ++t->pending;  // guard against completion while queueing
+
+  // writes back-to-back, followed by the verification reads
+  for (TransactionEntry& entry : t->entries) {
+    CbArg* arg = new CbArg(this, entry.dp, true, entry.update);
+    arg->t = t;
+    if (_optolink->write(entry.dp->getAddress(), entry.dp->getLength(), entry.data, reinterpret_cast<void*>(arg))) {
+      ++t->pending;
+    } else {
+      delete arg;
+      t->fail(entry.dp);
+    }
+  }
+  for (TransactionEntry& entry : t->entries) {
+    CbArg* arg = new CbArg(this, entry.dp, false, 0, entry.data);
+    arg->t = t;
+    if (_optolink->read(entry.dp->getAddress(), entry.dp->getLength(), reinterpret_cast<void*>(arg))) {
+      ++t->pending;
+    } else {
+      delete arg;
+      t->fail(entry.dp);
+    }
+  }
+
+  _transactionDone(t);
+}
+
+void VitoConnect::_onTransactionData(CbArg* cbArg, uint8_t* data, uint8_t len) {
+  if (cbArg->w) {
+    ESP_LOGD(TAG, "Write operation for datapoint with address %x has been completed.", cbArg->dp->getAddress());
+  } else {
+    if (len != cbArg->dp->getLength()) {
+      ESP_LOGW(TAG, "Expected length of %d was not met for datapoint with address %x.", cbArg->dp->getLength(), cbArg->dp->getAddress());
+      cbArg->t->fail(cbArg->dp);
+    } else if (!cbArg->dp->verify(cbArg->d, data, len)) {
+      ESP_LOGW(TAG, "Previous write operation for datapoint with address %x failed verification.", cbArg->dp->getAddress());
+      cbArg->t->fail(cbArg->dp);
+    }
+    _readSucceeded(cbArg->dp);
+    cbArg->dp->setLastRead(_clock->now());
+    _storeRaw(cbArg->dp, data, len);
+  }
+  _transactionDone(cbArg->t);
+}
+
+void VitoConnect::_transactionDone(Transaction* t) {
+  if (t->pending > 0 && --t->pending > 0) return;
+
+  if (t->failed > 0) {
+    ESP_LOGW(TAG, "Write transaction failed for %d of %d datapoint(s).", t->failed, (int) t->entries.size());
+  } else {
+    ESP_LOGD(TAG, "Write transaction of %d datapoint(s) was successfully verified.", (int) t->entries.size());
+  }
+  for (TransactionEntry& entry : t->entries) {
+    // only the failed entries are reported and retried, the others did land on the device;
+    // datapoints that were modified again meanwhile start over
+    bool current = entry.dp->getLastUpdate() == entry.update;
+    if (entry.failed) {
+      entry.dp->onError(VERIFICATION, entry.dp);
+      if (_onErrorCb) _onErrorCb(VERIFICATION, entry.dp);
+      if (current) _writeFailed(entry.dp);
+    } else if (current) {
+      entry.dp->clearLastUpdate();
+      entry.dp->writeCommitted();
+    }
+    delete[] entry.data;
+  }
+  delete t;
+  _transaction = nullptr;
+}
+
+void VitoConnect::_writeFailed(Datapoint* dp) {
+  if (dp->writeFailed(_writeRetries)) {
+    // restore the value the device actually holds
+    ESP_LOGW(TAG, "Giving up writing datapoint with address %x, rolling back.", dp->getAddress());
+    dp->decodeRaw();
+  } else {
+    ESP_LOGD(TAG, "Write of datapoint with address %x will be retried.", dp->getAddress());
+  }
+}
+
+void VitoConnect::_readMembers(DatapointGroup* group, uint8_t first, uint8_t count) {
+  uint16_t address = group->getDatapoints()[first]->getAddress();
+  CbArg* arg = new CbArg(this, group, first, count);
+  if (_optolink->read(address, group->getRangeLength(first, count), reinterpret_cast<void*>(arg))) {
+    group->addPending();
+  } else {
+    delete arg;
+  }
+}
+
+void VitoConnect::_onBlockData(CbArg* cbArg, uint8_t* data, uint8_t len) {
+  const std::vector<Datapoint*>& dps = cbArg->g->getDatapoints();
+  uint16_t address = dps[cbArg->f]->getAddress();
+  uint8_t length = cbArg->g->getRangeLength(cbArg->f, cbArg->c);
+  if (len != length) {
+    ESP_LOGW(TAG, "Expected length of %d was not met for block with address %x.", length, address);
+    _onBlockError(cbArg, LENGTH);
+    return;
+  }
+
+  // split the block into its members
+  for (uint8_t i = cbArg->f; i < cbArg->f + cbArg->c; ++i) {
+    _readSucceeded(dps[i]);
+    if (_onDataCb) _onDataCb(&data[dps[i]->getAddress() - address], dps[i]->getLength(), dps[i]);
+    _storeRaw(dps[i], &data[dps[i]->getAddress() - address], dps[i]->getLength());
+  }
+
+  if (cbArg->g->membersReceived(cbArg->f, cbArg->c)) {
+    cbArg->g->markComplete(_clock->now());
+  }
+}
+
+void VitoConnect::_onBlockError(CbArg* cbArg, uint8_t error) {
+  const std::vector<Datapoint*>& dps = cbArg->g->getDatapoints();
+  ESP_LOGD(TAG, "Error %s received for block with address %x and length %d", optolinkErrorToString(error),
+           dps[cbArg->f]->getAddress(), cbArg->g->getRangeLength(cbArg->f, cbArg->c));
+
+  if (error == VITO_ERROR && cbArg->c > 1) {
+    // the device rejected the range, one of the members may be at fault:
+    // read them one by one so that only the failing ones are penalized
+    for (uint8_t i = cbArg->f; i < cbArg->f + cbArg->c; ++i) {
+      _readMembers(cbArg->g, i, 1);
+    }
+  } else {
+    for (uint8_t i = cbArg->f; i < cbArg->f + cbArg->c; ++i) {
+      _readFailed(dps[i], error);
+      dps[i]->onError(error, dps[i]);
+      if (_onErrorCb) _onErrorCb(error, dps[i]);
+    }
+  }
+
+  if (cbArg->g->blockFailed()) {
+    cbArg->g->markComplete(_clock->now());
+  }
+}
+
+void VitoConnect::_stage(Datapoint* dp) {
+  // the value is decoded from the raw cache once it is its turn
+  if (!dp->isStaged() && _ready.push(dp)) {
+    dp->setStaged(true);
+    _publishHighWater = std::max(_publishHighWater, _ready.size());
+  } else if (!dp->isStaged()) {
+    ESP_LOGW(TAG, "Publish queue full, decoding datapoint with address %x directly.", dp->getAddress());
+    if (dp->getLastUpdate() == 0) {  // do not overwrite a pending write
+      dp->decodeRaw();
+    }
+  }
+}
+
+void VitoConnect::_storeRaw(Datapoint* dp, uint8_t* data, uint8_t len) {
+  // remember listeners of datapoints whose raw bytes changed
+  if (dp->updateRaw(data, len)) {
+    for (DatapointListener* listener : dp->getListeners()) {
+      if (std::find(_changedListeners.begin(), _changedListeners.end(), listener) == _changedListeners.end()) {
+        _changedListeners.push_back(listener);
+      }
+    }
+  }
+}
+
+void VitoConnect::_onTrace(bool tx, const uint8_t* data, uint8_t len, uint32_t timestamp, void* arg) {
+  VitoConnect* hub = reinterpret_cast<VitoConnect*>(arg);
+  ESP_LOGD(TAG, "Trace hub %d %s %" PRIu32 ": %s", hub->_hubIndex, tx ? "TX" : "RX", timestamp, format_hex_pretty(data, len).c_str());
+}
+
 void VitoConnect::_onError(uint8_t error, void* arg) {
-  ESP_LOGD(TAG, "Error received: %d", error);
   CbArg* cbArg = reinterpret_cast<CbArg*>(arg);
+  cbArg->v->_diagnostics.latency(cbArg->v->_clock->now() - cbArg->ts);
+  ++cbArg->v->_errorCount;
+  if (cbArg->g != nullptr) {
+    cbArg->v->_onBlockError(cbArg, error);
+    delete cbArg;
+    return;
+  }
+  ESP_LOGD(TAG, "Error %s received for datapoint with address %x", optolinkErrorToString(error), cbArg->dp->getAddress());
+  if (cbArg->t != nullptr) {
+    // the data buffer belongs to the transaction
+    cbArg->dp->onError(error, cbArg->dp);
+    if (cbArg->v->_onErrorCb) cbArg->v->_onErrorCb(error, cbArg->dp);
+    cbArg->t->fail(cbArg->dp);
+    cbArg->v->_transactionDone(cbArg->t);
+    delete cbArg;
+    return;
+  }
+  if (cbArg->m != 0) {
+    cbArg->v->_verifyMaskedFailed(cbArg, error);
+    delete cbArg;
+    return;
+  }
+  if (!cbArg->w && cbArg->d == nullptr) {
+    cbArg->dp->setReading(false);
+    cbArg->v->_readFailed(cbArg->dp, error);
+  }
+  cbArg->dp->onError(error, cbArg->dp);
   if (cbArg->v->_onErrorCb) cbArg->v->_onErrorCb(error, cbArg->dp);
   // Free the data buffer if it was allocated for verification
   if (cbArg->d != nullptr) {
@@ -30,6 +30,10 @@
 #include "vitoconnect_optolinkP300.h"
 #include "vitoconnect_optolinkKW.h"
 #include "vitoconnect_datapoint.h"
+#include "vitoconnect_group.h"
+#include "vitoconnect_automation.h"
+#include "vitoconnect_coordinator.h"
+#include "vitoconnect_diagnostics.h"
 
 using namespace std;
 
@@ -50,10 +54,52 @@ class VitoConnect : public uart::UARTDevice, public PollingComponent {
     void update() override;
 
     void set_protocol(std::string protocol) { this->protocol = protocol; }
+    void set_stale_factor(uint8_t factor) { this->_staleFactor = factor; }
+    void set_quarantine_after(uint8_t errors) { this->_quarantineAfter = errors; }
+    void set_reprobe_interval(uint32_t interval) { this->_reprobeInterval = interval; }
+    void set_write_retries(uint8_t retries) { this->_writeRetries = retries; }
+
+    /**
+     * @brief Log the diagnostics at most once per interval (ms), 0 disables the report.
+     */
+    void set_diagnostics_interval(uint32_t interval) { this->_diagnosticsInterval = interval; }
+
+    /**
+     * @brief Clock passed down to the optolink and all datapoints on setup.
+     */
+    void set_clock(MonotonicClock* clock) { this->_clock = clock; }
+
+    /**
+     * @brief Log every frame on the wire with its timestamp.
+     */
+    void set_trace(bool trace) { this->_trace = trace; }
+    void set_publish_budget(uint8_t budget) { Coordinator::instance()->setPublishBudget(budget); }
+    void set_publish_time_budget(uint32_t budget) { Coordinator::instance()->setPublishTimeBudget(budget); }
     void register_datapoint(Datapoint *datapoint);
+    void register_listener(DatapointListener *listener, Datapoint *datapoint);
+    void register_group(DatapointGroup *group);
+
+    /**
+     * @brief Attach callbacks for the data or errors of all datapoints of this hub.
+     */
+    void onData(DatapointDataCallback callback) { this->_onDataCb = callback; }
+    void onError(DatapointErrorCallback callback) { this->_onErrorCb = callback; }
 
-    void onData(std::function<void(const uint8_t* data, uint8_t length, Datapoint* dp)> callback);
-    void onError(std::function<void(uint8_t, Datapoint*)> callback);
+    /**
+     * @brief Link statistics since boot.
+     */
+    uint32_t getAnswerCount() { return this->_answerCount; }
+    uint32_t getErrorCount() { return this->_errorCount; }
+    uint32_t getSkippedWriteCount() { return this->_skippedWrites; }
+
+    /**
+     * @brief Log live requests, high-water marks, latency and error rate.
+     */
+    void logDiagnostics();
+    Diagnostics& getDiagnostics() { return this->_diagnostics; }
+    size_t getQueueHighWater() { return this->_optolink ? this->_optolink->getQueueHighWater() : 0; }
+    size_t getPublishHighWater() { return this->_publishHighWater; }
+    uint32_t getStallCount() { return this->_optolink ? this->_optolink->getStallCount() : 0; }
 
     /**
      * @brief Enqueue a datapoint for writing.
@@ -73,26 +119,120 @@ class VitoConnect : public uart::UARTDevice, public PollingComponent {
   protected:
 
   private:
-    Optolink* _optolink;
+    Optolink* _optolink = nullptr;
+    MonotonicClock* _clock = SystemClock::instance();
+    bool _trace = false;
+    uint8_t _hubIndex = 0;
+    Diagnostics _diagnostics;
+    size_t _publishHighWater = 0;
+    uint32_t _answerCount = 0;
+    uint32_t _errorCount = 0;
+    uint32_t _skippedWrites = 0;
+    SimpleQueue<Datapoint*> _ready{0};
+    void _poll();
+    void _stage(Datapoint* dp);
     std::vector<Datapoint*> _datapoints;
+    std::vector<DatapointListener*> _changedListeners;
+    std::vector<DatapointGroup*> _groups;
     std::string protocol;
+    uint8_t _staleFactor = 0;
+    uint8_t _quarantineAfter = 0;
+    uint32_t _reprobeInterval = 0;
+    uint8_t _writeRetries = WRITE_RETRIES_UNLIMITED;
+    uint32_t _lastData = 0;
+    uint32_t _pollAt = 0;
+    uint32_t _diagnosticsInterval = 0;
+    uint32_t _lastDiagnostics = 0;
+    bool _pollScheduled = false;
+    void _checkStale();
+    void _readFailed(Datapoint* dp, uint8_t error);
+    void _readSucceeded(Datapoint* dp);
+    void _writeFailed(Datapoint* dp);
+    /**
+     * @brief Writes of several datapoints that are queued back-to-back and
+     *        verified as a batch. If any write or verification fails, the
+     *        transaction fails as a whole and all writes are retried.
+     */
+    struct TransactionEntry {
+      Datapoint* dp;
+      uint8_t* data;
+      uint32_t update;  // _last_update of the datapoint when it was encoded
+      bool failed;
+    };
+    struct Transaction {
+      std::vector<TransactionEntry> entries;
+      uint8_t pending = 0;
+      uint8_t failed = 0;
+      void fail(Datapoint* dp) {
+        for (TransactionEntry& entry : entries) {
+          if (entry.dp == dp && !entry.failed) {
+            entry.failed = true;
+            ++failed;
+          }
+        }
+      }
+      void failAll() {
+        for (TransactionEntry& entry : entries) fail(entry.dp);
+      }
+    };
+    Transaction* _transaction = nullptr;
+    void _commit(Transaction* t);
+    void _transactionDone(Transaction* t);
     struct CbArg {
       CbArg(VitoConnect* vw, Datapoint* d, bool write, uint32_t last_update, uint8_t* data = nullptr) :
         v(vw),
         dp(d),
         w(write),
         la(last_update),
-        d(data) {}
+        d(data),
+        g(nullptr),
+        f(0),
+        c(0),
+        m(0),
+        r(false),
+        t(nullptr),
+        ts(vw->_clock->now()) { vw->_diagnostics.allocated(); }
+      CbArg(VitoConnect* vw, DatapointGroup* group, uint8_t first, uint8_t count) :
+        v(vw),
+        dp(nullptr),
+        w(false),
+        la(0),
+        d(nullptr),
+        g(group),
+        f(first),
+        c(count),
+        m(0),
+        r(false),
+        t(nullptr),
+        ts(vw->_clock->now()) { vw->_diagnostics.allocated(); }
+      ~CbArg() { v->_diagnostics.freed(); }
       VitoConnect* v;
       Datapoint* dp;
       bool w;
       uint32_t la;
       uint8_t* d;
+      DatapointGroup* g;  // only set for reads of group members
+      uint8_t f;          // index of the first member read
+      uint8_t c;          // number of members read
+      uint8_t m;          // merged mask of a partial write
+      bool r;             // read of the current byte before a partial write
+      Transaction* t;     // only set for requests of a write transaction
+      uint32_t ts;        // time the request was queued
     };
     static void _onData(uint8_t* data, uint8_t len, void* arg);
     static void _onError(uint8_t error, void* arg);
-
-    std::function<void(uint8_t, Datapoint*)> _onErrorCb;
+    static void _onTrace(bool tx, const uint8_t* data, uint8_t len, uint32_t timestamp, void* arg);
+    void _onBlockData(CbArg* cbArg, uint8_t* data, uint8_t len);
+    void _onBlockError(CbArg* cbArg, uint8_t error);
+    void _readMembers(DatapointGroup* group, uint8_t first, uint8_t count);
+    void _onTransactionData(CbArg* cbArg, uint8_t* data, uint8_t len);
+    void _storeRaw(Datapoint* dp, uint8_t* data, uint8_t len);
+    bool _writeMasked(uint16_t address);
+    void _verifyMasked(CbArg* cbArg, uint8_t* data, uint8_t len);
+    void _verifyMaskedFailed(CbArg* cbArg, uint8_t error);
+
+    DatapointDataCallback _onDataCb = nullptr;
+    DatapointErrorCallback _onErrorCb = nullptr;
 };
 
 }  // namespace vitoconnect
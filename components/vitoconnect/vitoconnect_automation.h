@@ -0,0 +1,41 @@
+/*
+  vitoconnect_automation.h - Triggers of datapoint backed entities
+
+  Copyright (C) 2026  vitoconnect contributors
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "esphome/core/automation.h"
+#include "vitoconnect_datapoint.h"
+
+namespace esphome {
+namespace vitoconnect {
+
+/**
+ * @brief Trigger fired when a request for the datapoint failed.
+ *
+ * The error code (OptolinkError) is passed as argument `error`.
+ */
+class ErrorTrigger : public Trigger<uint8_t> {
+  public:
+    explicit ErrorTrigger(Datapoint *datapoint) {
+      datapoint->add_on_error_callback([this](uint8_t error) { this->trigger(error); });
+    }
+};
+
+}  // namespace vitoconnect
+}  // namespace esphome
@@ -0,0 +1,126 @@
+/*
+  vitoconnect_clock.cpp - Device clock synchronisation with an ESPHome time source
+
+  Copyright (C) 2026  vitoconnect contributors
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "vitoconnect_clock.h"
+
+#ifdef USE_TIME
+
+namespace esphome {
+namespace vitoconnect {
+
+static const char *TAG = "vitoconnect.clock";
+
+static bool fromBcd(uint8_t value, uint8_t* result) {
+  if ((value >> 4) > 9 || (value & 0x0F) > 9) return false;
+  *result = (value >> 4) * 10 + (value & 0x0F);
+  return true;
+}
+
+static uint8_t toBcd(uint8_t value) {
+  return (value / 10) << 4 | (value % 10);
+}
+
+/**
+ * @brief Seconds since 1970-01-01 of a local date and time, no time zone applied.
+ */
+static int64_t toSeconds(int32_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t minute, uint8_t second) {
+  // days from civil (proleptic Gregorian calendar)
+  year -= month <= 2;
+  int32_t era = (year >= 0 ? year : year - 399) / 400;
+  uint32_t yoe = year - era * 400;
+  uint32_t doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+  uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  int64_t days = (int64_t) era * 146097 + doe - 719468;
+  return days * 86400 + hour * 3600 + minute * 60 + second;
+}
+
+static bool deviceSeconds(const uint8_t* data, int64_t* seconds) {
+  uint8_t century, year, month, day, hour, minute, second;
+  if (!fromBcd(data[0], &century) || !fromBcd(data[1], &year) || !fromBcd(data[2], &month) || !fromBcd(data[3], &day) ||
+      !fromBcd(data[5], &hour) || !fromBcd(data[6], &minute) || !fromBcd(data[7], &second) ||
+      month < 1 || month > 12 || day < 1 || day > 31) {
+    return false;
+  }
+  *seconds = toSeconds(century * 100 + year, month, day, hour, minute, second);
+  return true;
+}
+
+void ClockSync::decode(uint8_t* data, uint8_t length, Datapoint* dp) {
+  assert(length >= 8);
+  ESPTime now = _time->now();
+  if (!now.is_valid()) {
+    ESP_LOGD(TAG, "Time source not valid yet, skipping clock check");
+    return;
+  }
+  if (this->getLastUpdate() != 0) return;  // correction already pending
+
+  // the rollback of a failed correction decodes the old value again, which must
+  // not re-arm the write with a fresh retry budget: wait for the next regular read
+  if (this->getWriteState() == WRITE_ROLLED_BACK) {
+    if (!_gaveUp) {
+      ESP_LOGW(TAG, "Device clock could not be corrected, retrying after the next read");
+      _gaveUp = true;
+      _gaveUpRead = this->getLastRead();
+      return;
+    }
+    if (this->getLastRead() == _gaveUpRead) return;
+  }
+
+  int64_t device = 0;
+  if (!deviceSeconds(data, &device)) {
+    ESP_LOGW(TAG, "Device time is not valid BCD, synchronizing");
+    _gaveUp = false;
+    this->markPending();
+    return;
+  }
+
+  int64_t drift = device - toSeconds(now.year, now.month, now.day_of_month, now.hour, now.minute, now.second);
+  ESP_LOGD(TAG, "Device clock drift: %d s", (int) drift);
+  if (drift > (int64_t) _maxDrift || -drift > (int64_t) _maxDrift) {
+    ESP_LOGI(TAG, "Device clock drifted by %d s, synchronizing", (int) drift);
+    _gaveUp = false;
+    this->markPending();
+  }
+}
+
+void ClockSync::encode(uint8_t* raw, uint8_t length) {
+  assert(length == 8);
+  ESPTime now = _time->now();
+  raw[0] = toBcd(now.year / 100);
+  raw[1] = toBcd(now.year % 100);
+  raw[2] = toBcd(now.month);
+  raw[3] = toBcd(now.day_of_month);
+  raw[4] = toBcd(now.day_of_week == 1 ? 7 : now.day_of_week - 1);  // 1 = monday
+  raw[5] = toBcd(now.hour);
+  raw[6] = toBcd(now.minute);
+  raw[7] = toBcd(now.second);
+}
+
+bool ClockSync::verify(const uint8_t* written, const uint8_t* data, uint8_t length) {
+  // the device clock keeps running between write and read back
+  int64_t expected = 0;
+  int64_t actual = 0;
+  if (!deviceSeconds(written, &expected) || !deviceSeconds(data, &actual)) return false;
+  return actual >= expected && actual - expected <= (int64_t) _maxDrift;
+}
+
+}  // namespace vitoconnect
+}  // namespace esphome
+
+#endif  // USE_TIME
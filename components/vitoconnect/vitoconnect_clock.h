@@ -0,0 +1,58 @@
+/*
+  vitoconnect_clock.h - Device clock synchronisation with an ESPHome time source
+
+  Copyright (C) 2026  vitoconnect contributors
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#ifdef USE_TIME
+
+#include "esphome/components/time/real_time_clock.h"
+#include "vitoconnect_datapoint.h"
+
+namespace esphome {
+namespace vitoconnect {
+
+/**
+ * @brief Keeps the system time of the device (8 bytes BCD: YYYY MM DD WD hh mm ss)
+ *        in sync with an ESPHome time source.
+ *
+ * The time is read with its own (slow) poll interval and only written back
+ * through the regular write/verify path once the drift exceeds the threshold.
+ */
+class ClockSync : public Datapoint {
+
+  public:
+    explicit ClockSync(time::RealTimeClock* time) : _time(time) {}
+
+    void set_max_drift(uint32_t drift) { this->_maxDrift = drift; }
+
+    void decode(uint8_t* data, uint8_t length, Datapoint* dp = nullptr) override;
+    void encode(uint8_t* raw, uint8_t length) override;
+    bool verify(const uint8_t* written, const uint8_t* data, uint8_t length) override;
+
+  protected:
+    time::RealTimeClock* _time;
+    uint32_t _maxDrift = 0;  // seconds
+    bool _gaveUp = false;  // the last correction was rolled back
+    uint32_t _gaveUpRead = 0;  // read the rollback was decoded from
+};
+
+}  // namespace vitoconnect
+}  // namespace esphome
+
+#endif  // USE_TIME
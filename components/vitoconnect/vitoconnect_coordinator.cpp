@@ -0,0 +1,88 @@
+/*
+  vitoconnect_coordinator.cpp - Scheduling shared by several vitoconnect hubs on one ESP
+
+  Copyright (C) 2026  vitoconnect contributors
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "vitoconnect_coordinator.h"
+#include "vitoconnect.h"
+
+#include <cinttypes>
+
+namespace esphome {
+namespace vitoconnect {
+
+static const char *TAG = "vitoconnect.coordinator";
+
+Coordinator* Coordinator::instance() {
+  static Coordinator coordinator;
+  return &coordinator;
+}
+
+uint8_t Coordinator::registerHub(VitoConnect* hub) {
+  _hubs.push_back(hub);
+  return _hubs.size() - 1;
+}
+
+uint32_t Coordinator::getPhaseOffset(uint8_t index, uint32_t interval) {
+  if (_hubs.size() < 2) return 0;
+  return interval / _hubs.size() * index;
+}
+
+void Coordinator::setPublishBudget(uint8_t budget) {
+  if (budget != 0 && (_budget == 0 || budget < _budget)) {
+    _budget = budget;
+  }
+}
+
+void Coordinator::setPublishTimeBudget(uint32_t budget) {
+  if (budget != 0 && (_timeBudget == 0 || budget < _timeBudget)) {
+    _timeBudget = budget;
+  }
+}
+
+void Coordinator::beginLoop(VitoConnect* hub) {
+  if (!_hubs.empty() && _hubs.front() == hub) {
+    _remaining = _budget;
+    _spent = 0;
+  }
+}
+
+bool Coordinator::consumeBudget(uint8_t count) {
+  if (_timeBudget != 0 && _spent >= _timeBudget) return false;
+  if (_budget == 0) return true;
+  if (_remaining == 0) return false;
+  _remaining = count < _remaining ? _remaining - count : 0;
+  return true;
+}
+
+void Coordinator::logStatistics() {
+  uint32_t answers = 0;
+  uint32_t errors = 0;
+  uint32_t stalls = 0;
+  uint32_t skipped = 0;
+  for (VitoConnect* hub : _hubs) {
+    answers += hub->getAnswerCount();
+    errors += hub->getErrorCount();
+    stalls += hub->getStallCount();
+    skipped += hub->getSkippedWriteCount();
+  }
+  ESP_LOGD(TAG, "Link statistics of %zu hub(s): %" PRIu32 " answers, %" PRIu32 " errors, %" PRIu32 " stalls, %" PRIu32 " skipped writes",
+           _hubs.size(), answers, errors, stalls, skipped);
+}
+
+}  // namespace vitoconnect
+}  // namespace esphome
@@ -0,0 +1,109 @@
+/*
+  vitoconnect_coordinator.h - Scheduling shared by several vitoconnect hubs on one ESP
+
+  Copyright (C) 2026  vitoconnect contributors
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+namespace esphome {
+namespace vitoconnect {
+
+class VitoConnect;
+
+/**
+ * @brief Schedule shared by all VitoConnect hubs on one device.
+ *
+ * The coordinator offsets the polling phase of the hubs against each other,
+ * limits the number of publishes per main loop pass over all hubs and
+ * reports combined link statistics.
+ */
+class Coordinator {
+  public:
+    static Coordinator* instance();
+
+    /**
+     * @brief Add a hub to the schedule.
+     *
+     * @return uint8_t Index of the hub, used to offset its polling phase.
+     */
+    uint8_t registerHub(VitoConnect* hub);
+    uint8_t getHubCount() { return this->_hubs.size(); }
+
+    /**
+     * @brief Offset (ms) of a hub's polling cycle within its update interval.
+     */
+    uint32_t getPhaseOffset(uint8_t index, uint32_t interval);
+
+    /**
+     * @brief Limit the publishes per main loop pass over all hubs, 0 = unlimited.
+     *
+     * With several hubs, the smallest configured budget is used.
+     */
+    void setPublishBudget(uint8_t budget);
+
+    /**
+     * @brief Limit the time (us) spent publishing per main loop pass over all
+     *        hubs, 0 = unlimited.
+     *
+     * With several hubs, the smallest configured budget is used.
+     */
+    void setPublishTimeBudget(uint32_t budget);
+
+    /**
+     * @brief Account time (us) spent publishing in the current loop pass.
+     */
+    void addPublishTime(uint32_t time) { this->_spent += time; }
+
+    /**
+     * @brief Called by every hub at the start of its loop, the budget is
+     *        renewed when the first hub is called (ie. once per loop pass).
+     */
+    void beginLoop(VitoConnect* hub);
+
+    /**
+     * @brief Take publishes from the budget of the current loop pass.
+     *
+     * A batch is allowed as long as budget is left, so groups bigger than
+     * the budget are still published together.
+     *
+     * @return true The publishes may be done in this loop pass.
+     */
+    bool consumeBudget(uint8_t count = 1);
+
+    /**
+     * @brief Time (us) spent publishing in the current loop pass so far.
+     */
+    uint32_t getPublishTime() { return this->_spent; }
+
+    /**
+     * @brief Log the link statistics of all hubs.
+     */
+    void logStatistics();
+
+  private:
+    std::vector<VitoConnect*> _hubs;
+    uint8_t _budget = 0;
+    uint8_t _remaining = 0;
+    uint32_t _timeBudget = 0;
+    uint32_t _spent = 0;
+};
+
+}  // namespace vitoconnect
+}  // namespace esphome
@@ -25,21 +25,64 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "vitoconnect_datapoint.h"
 
+#include "esphome/core/hal.h"
+
 namespace esphome {
 namespace vitoconnect {
 
-std::function<void(uint8_t[], uint8_t, Datapoint* dp)> Datapoint::_stdOnData = nullptr;
-
 Datapoint::Datapoint(){
   // empty
 }
 
 Datapoint::~Datapoint() {
-  // empty
+  delete[] _raw;
+}
+
+void Datapoint::setLength(uint8_t length) {
+  this->_length = length;
+  delete[] _raw;
+  _raw = new uint8_t[length];
+  _rawValid = false;
+}
+
+bool Datapoint::updateRaw(const uint8_t* data, uint8_t length) {
+  if (length != _length) {
+    return false;
+  }
+  if (_rawValid && memcmp(_raw, data, length) == 0) {
+    return false;
+  }
+  memcpy(_raw, data, length);
+  _rawValid = true;
+  return true;
 }
 
-void Datapoint::onData(std::function<void(uint8_t[], uint8_t, Datapoint* dp)> callback) {
-  _stdOnData = callback;
+void Datapoint::markPending() {
+  _last_update = _clock->now();
+  _writeState = WRITE_PENDING;
+  _writeAttempts = 0;
+  _writeSkip = 0;
+  _writeDeferred = false;
+}
+
+bool Datapoint::writeFailed(uint8_t retries) {
+  if (retries == WRITE_RETRIES_UNLIMITED) return false;
+  if (++_writeAttempts > retries) {
+    _last_update = 0;
+    _writeState = WRITE_ROLLED_BACK;
+    _writeAttempts = 0;
+    _writeSkip = 0;
+    return true;
+  }
+  // wait 0, 1, 3, 7, ... cycles before the next attempt
+  _writeSkip = (1 << (_writeAttempts - 1)) - 1;
+  return false;
+}
+
+void Datapoint::onError(uint8_t error, Datapoint* dp) {
+  _lastError = error;
+  _lastErrorTime = _clock->now();
+  _errorCallback.call(error);
 }
 
 void Datapoint::encode(uint8_t* raw, uint8_t length) {
@@ -56,15 +99,7 @@ void Datapoint::encode(uint8_t* raw, uint8_t length, void* data) {
 }
 
 void Datapoint::decode(uint8_t* data, uint8_t length, Datapoint* dp) {
-  uint8_t* output = new uint8_t[_length];
-  memset(output, 0, _length);
-  if (length != _length) {
-    // display error about length
-  } else {
-    memcpy(output, data, length);
-    if (_stdOnData) _stdOnData(output, _length, dp);
-  }
-  delete[] output;
+  // raw datapoints have no entity to publish to, use the hub's onData callback instead
 }
 
 }  // namespace vitoconnect
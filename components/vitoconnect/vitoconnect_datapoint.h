@@ -28,11 +28,53 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <stdint.h>
 #include <assert.h>
 #include <functional>
+#include <vector>
 #include <string.h>  // for memcpy
 
+#include "esphome/core/helpers.h"
+#include "vitoconnect_monotonic.h"
+
 namespace esphome {
 namespace vitoconnect {
 
+class DatapointGroup;
+
+/**
+ * @brief Interface for objects computed from the raw value of one or more
+ *        datapoints (eg. derived sensors).
+ *
+ * Listeners are notified by the VitoConnect hub once the bytes of one of
+ * their input datapoints changed and the current polling cycle is done.
+ */
+class DatapointListener {
+ public:
+  virtual ~DatapointListener() {}
+  virtual void onDatapointChanged() = 0;
+};
+
+class Datapoint;
+
+/**
+ * @brief Callbacks a VitoConnect hub calls for each datapoint's data or error.
+ */
+typedef void (*DatapointDataCallback)(const uint8_t* data, uint8_t length, Datapoint* dp);
+typedef void (*DatapointErrorCallback)(uint8_t error, Datapoint* dp);
+
+/**
+ * @brief Retry failed writes forever instead of rolling them back.
+ */
+static const uint8_t WRITE_RETRIES_UNLIMITED = 0xFF;
+
+/**
+ * @brief State of the last value set through an entity.
+ */
+enum WriteState : uint8_t {
+  WRITE_IDLE,        ///< No value set yet
+  WRITE_PENDING,     ///< Value published optimistically, waiting for verification
+  WRITE_COMMITTED,   ///< Value was written and verified
+  WRITE_ROLLED_BACK  ///< Writing failed too often, the device value was restored
+};
+
 class Datapoint {
 
  public:
@@ -42,24 +84,180 @@ class Datapoint {
   void setAddress(uint16_t address) {  this->_address = address; };
   uint16_t getAddress() { return this->_address; };
   
-  void setLength(uint8_t length) {  this->_length = length; };
+  void setLength(uint8_t length);
+
+  void setClock(MonotonicClock* clock) { this->_clock = clock; };
   uint8_t getLength() { return this->_length; };
 
-  static void onData(std::function<void(uint8_t[], uint8_t, Datapoint* dp)> callback);
-  void onError(uint8_t, Datapoint* dp);
+  /**
+   * @brief Bits of a single byte datapoint that belong to this entity,
+   *        0 if the whole value is used. Writes of masked datapoints
+   *        are merged into the current byte (read-modify-write).
+   */
+  void setMask(uint8_t mask) { this->_mask = mask; };
+  uint8_t getMask() { return this->_mask; };
+  uint8_t getShift() { return this->_mask ? __builtin_ctz(this->_mask) : 0; };
+
+  /**
+   * @brief Minimum time (ms) between two reads, 0 reads in every polling cycle.
+   */
+  void setPollInterval(uint32_t interval) { this->_pollInterval = interval; };
+  uint32_t getPollInterval() { return this->_pollInterval; };
+
+  /**
+   * @brief Store the raw bytes of the last successful read.
+   *
+   * @return true The cached bytes changed (or were not valid before).
+   * @return false The received bytes equal the cached ones.
+   */
+  bool updateRaw(const uint8_t* data, uint8_t length);
+  const uint8_t* getRaw() { return this->_rawValid ? this->_raw : nullptr; };
+  void decodeRaw() { if (this->_rawValid) decode(this->_raw, this->_length, this); };
+
+  void setGroup(DatapointGroup* group) { this->_group = group; };
+  DatapointGroup* getGroup() { return this->_group; };
+
+  void addListener(DatapointListener* listener) { this->_listeners.push_back(listener); };
+  const std::vector<DatapointListener*>& getListeners() { return this->_listeners; };
+
+  void onError(uint8_t error, Datapoint* dp = nullptr);
+  void add_on_error_callback(std::function<void(uint8_t)> &&callback) { this->_errorCallback.add(std::move(callback)); }
+
+  /**
+   * @brief Last error (OptolinkError) received for this datapoint and the
+   *        time (millis) it was received, 0 if no error occurred yet.
+   */
+  uint8_t getLastError() { return _lastError; };
+  uint32_t getLastErrorTime() { return _lastErrorTime; };
 
   virtual void encode(uint8_t* raw, uint8_t length);
   virtual void encode(uint8_t* raw, uint8_t length, void* data);
   virtual void decode(uint8_t* data, uint8_t length, Datapoint* dp = nullptr);
 
+  /**
+   * @brief Compare the bytes read back after a write with the written ones.
+   */
+  virtual bool verify(const uint8_t* written, const uint8_t* data, uint8_t length) { return memcmp(written, data, length) == 0; }
+
   uint32_t getLastUpdate() { return _last_update; };
   void clearLastUpdate() { this->_last_update = 0; }
 
+  /**
+   * @brief Request a write of the current (optimistically published) value.
+   */
+  void markPending();
+  WriteState getWriteState() { return _writeState; };
+  void writeCommitted() { this->_writeState = WRITE_COMMITTED; this->_writeAttempts = 0; this->_writeSkip = 0; this->_writeDeferred = false; }
+
+  /**
+   * @brief Record a failed write and back off before the next attempt.
+   *        With WRITE_RETRIES_UNLIMITED the write is retried in every cycle
+   *        and never rolled back.
+   *
+   * @return true The retries are exhausted, the write was rolled back.
+   */
+  bool writeFailed(uint8_t retries);
+
+  /**
+   * @brief Check whether a pending write is backing off in the current cycle.
+   *        Call once per cycle, isWriteDeferred() repeats the result.
+   */
+  bool skipWrite() {
+    this->_writeDeferred = _writeSkip > 0;
+    if (this->_writeDeferred) --_writeSkip;
+    return this->_writeDeferred;
+  }
+  bool isWriteDeferred() { return _writeDeferred; }
+
+  /**
+   * @brief Time (millis) of the last successful read, 0 if never read.
+   */
+  uint32_t getLastRead() { return _last_read; };
+  void setLastRead(uint32_t timestamp) { this->_last_read = timestamp; this->_stale = false; }
+
+  /**
+   * @brief Marks a datapoint waiting in the hub's publish queue.
+   */
+  bool isStaged() { return _staged; };
+  void setStaged(bool staged) { this->_staged = staged; }
+
+  /**
+   * @brief Marks a poll read of this datapoint waiting in the Optolink queue.
+   */
+  bool isReading() { return _reading; };
+  void setReading(bool reading) { this->_reading = reading; }
+
+  bool isStale() { return _stale; };
+  void setStale() { this->_stale = true; invalidate(); }
+
+  /**
+   * @brief Consecutive failed reads of this datapoint.
+   */
+  uint8_t getErrorCount() { return _errorCount; };
+  bool isQuarantined() { return _quarantined; };
+
+  /**
+   * @brief Record a failed read and skip the next (backoff) polling cycles.
+   */
+  void readFailed(uint16_t backoff, bool quarantine) {
+    if (_errorCount < 255) ++_errorCount;
+    this->_skipCycles = backoff;
+    this->_quarantined = quarantine;
+  }
+
+  /**
+   * @brief Reset the error tracking after a successful read.
+   *
+   * @return true The datapoint was quarantined before.
+   */
+  bool readSucceeded() {
+    bool wasQuarantined = _quarantined;
+    this->_errorCount = 0;
+    this->_skipCycles = 0;
+    this->_quarantined = false;
+    return wasQuarantined;
+  }
+
+  /**
+   * @brief Check whether the datapoint is backing off in the current cycle.
+   */
+  bool skipCycle() {
+    if (_skipCycles == 0) return false;
+    --_skipCycles;
+    return true;
+  }
+
+  /**
+   * @brief Called once the value has not been read successfully for too
+   *        long. Entities should mark their state as unavailable.
+   */
+  virtual void invalidate() {}
+
  protected:
+  MonotonicClock* _clock = SystemClock::instance();
   uint32_t _last_update = 0;
+  WriteState _writeState = WRITE_IDLE;
+  uint8_t _writeAttempts = 0;
+  uint8_t _writeSkip = 0;
+  bool _writeDeferred = false;
+  uint32_t _last_read = 0;
+  bool _stale = false;
+  bool _staged = false;
+  bool _reading = false;
+  uint8_t _errorCount = 0;
+  uint16_t _skipCycles = 0;
+  bool _quarantined = false;
+  uint8_t _lastError = 0;
+  uint32_t _lastErrorTime = 0;
+  CallbackManager<void(uint8_t)> _errorCallback;
   uint16_t _address;
   uint8_t _length;
-  static std::function<void(uint8_t[], uint8_t, Datapoint* dp)> _stdOnData;
+  uint8_t _mask = 0;
+  uint32_t _pollInterval = 0;
+  uint8_t* _raw = nullptr;
+  bool _rawValid = false;
+  std::vector<DatapointListener*> _listeners;
+  DatapointGroup* _group = nullptr;
 };
 
 
@@ -0,0 +1,113 @@
+/*
+  vitoconnect_diagnostics.cpp - Runtime diagnostics of a vitoconnect hub
+
+  Copyright (C) 2026  vitoconnect contributors
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "vitoconnect_diagnostics.h"
+
+#include <cinttypes>
+#include <stdio.h>  // for snprintf
+#include <string.h>  // for memset
+
+#include "esphome/core/log.h"
+
+#ifdef USE_ESP32
+#include <esp_heap_caps.h>
+#endif
+#ifdef USE_ESP8266
+#include <Esp.h>
+#endif
+
+namespace esphome {
+namespace vitoconnect {
+
+static const char *TAG = "vitoconnect.diagnostics";
+
+// upper bounds (ms) of the latency buckets, the last one is open; a full queue
+// takes several seconds to drain, so the buckets reach up to a long update interval
+static const uint32_t LATENCY_BOUNDS[Diagnostics::LATENCY_BUCKETS] = {50, 100, 200, 500, 1000, 2000, 5000, 10000, 30000, UINT32_MAX};
+
+uint32_t (*Diagnostics::_heapProbe)() = nullptr;
+
+// the open bucket has no upper bound, it is reported as exceeding the last one
+static void formatBound(char* buff, size_t size, uint32_t bound) {
+  if (bound == UINT32_MAX) {
+    snprintf(buff, size, "> %" PRIu32 " ms", LATENCY_BOUNDS[Diagnostics::LATENCY_BUCKETS - 2]);
+  } else {
+    snprintf(buff, size, "<= %" PRIu32 " ms", bound);
+  }
+}
+
+void Diagnostics::allocated() {
+  ++_live;
+  if (_live > _liveHighWater) _liveHighWater = _live;
+}
+
+void Diagnostics::latency(uint32_t ms) {
+  uint8_t i = 0;
+  while (ms > LATENCY_BOUNDS[i]) ++i;
+  ++_latency[i];
+  ++_latencyCount;
+}
+
+uint32_t Diagnostics::percentile(uint8_t percent) {
+  if (_latencyCount == 0) return 0;
+  uint32_t rank = (uint64_t) _latencyCount * percent / 100;
+  uint32_t count = 0;
+  for (uint8_t i = 0; i < LATENCY_BUCKETS; ++i) {
+    count += _latency[i];
+    if (count > rank) return LATENCY_BOUNDS[i];
+  }
+  return LATENCY_BOUNDS[LATENCY_BUCKETS - 1];
+}
+
+void Diagnostics::sampleHeap() {
+#if defined(USE_ESP32)
+  _heapLowWater = heap_caps_get_minimum_free_size(MALLOC_CAP_DEFAULT);
+#elif defined(USE_ESP8266)
+  uint32_t free = ESP.getFreeHeap();
+  if (_heapLowWater == 0 || free < _heapLowWater) _heapLowWater = free;
+#else
+  if (_heapProbe) {
+    uint32_t free = _heapProbe();
+    if (_heapLowWater == 0 || free < _heapLowWater) _heapLowWater = free;
+  }
+#endif
+}
+
+void Diagnostics::log(uint8_t hub, uint32_t answers, uint32_t errors, size_t queueHighWater, size_t publishHighWater) {
+  uint32_t newAnswers = answers - _lastAnswers;
+  uint32_t newErrors = errors - _lastErrors;
+  _lastAnswers = answers;
+  _lastErrors = errors;
+  float errorRate = newAnswers + newErrors > 0 ? 100.0f * newErrors / (newAnswers + newErrors) : 0.0f;
+
+  ESP_LOGD(TAG, "Hub %d: %" PRIu32 " live requests (max %" PRIu32 "), queue max %zu, publish queue max %zu, heap min %" PRIu32 " bytes",
+           hub, _live, _liveHighWater, queueHighWater, publishHighWater, _heapLowWater);
+  char p50[20], p95[20], p99[20];
+  formatBound(p50, sizeof(p50), percentile(50));
+  formatBound(p95, sizeof(p95), percentile(95));
+  formatBound(p99, sizeof(p99), percentile(99));
+  ESP_LOGD(TAG, "Hub %d: latency p50 %s, p95 %s, p99 %s, error rate %.1f%% since last report",
+           hub, p50, p95, p99, errorRate);
+
+  memset(_latency, 0, sizeof(_latency));
+  _latencyCount = 0;
+}
+
+}  // namespace vitoconnect
+}  // namespace esphome
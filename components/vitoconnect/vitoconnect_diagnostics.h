@@ -0,0 +1,87 @@
+/*
+  vitoconnect_diagnostics.h - Runtime diagnostics of a vitoconnect hub
+
+  Copyright (C) 2026  vitoconnect contributors
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace esphome {
+namespace vitoconnect {
+
+/**
+ * @brief Runtime diagnostics of a hub for long running installations:
+ *        live request contexts, heap low-water mark, request latency
+ *        histogram and error rate between two reports.
+ */
+class Diagnostics {
+  public:
+    static const uint8_t LATENCY_BUCKETS = 10;
+
+    /**
+     * @brief Track the request contexts (CbArg) that are alive. A growing
+     *        count between cycles points to a leak in the callback paths.
+     */
+    void allocated();
+    void freed() { if (_live > 0) --_live; }
+    uint32_t getLive() { return _live; }
+    uint32_t getLiveHighWater() { return _liveHighWater; }
+
+    /**
+     * @brief Record the time (ms) from queueing a request to its answer,
+     *        including the wait behind the other requests of the cycle.
+     */
+    void latency(uint32_t ms);
+
+    /**
+     * @brief Upper bound (ms) of the latency bucket holding the given percentile,
+     *        UINT32_MAX for answers slower than 30000 ms.
+     */
+    uint32_t percentile(uint8_t percent);
+
+    /**
+     * @brief Update the lowest free heap seen so far, 0 if unsupported.
+     */
+    void sampleHeap();
+    uint32_t getHeapLowWater() { return _heapLowWater; }
+
+    /**
+     * @brief Free heap (bytes) on platforms sampleHeap() does not know, eg. host builds.
+     */
+    static void setHeapProbe(uint32_t (*probe)()) { _heapProbe = probe; }
+
+    /**
+     * @brief Log the diagnostics together with the latency and error rate
+     *        since the last report, both start over afterwards.
+     */
+    void log(uint8_t hub, uint32_t answers, uint32_t errors, size_t queueHighWater, size_t publishHighWater);
+
+  protected:
+    uint32_t _live = 0;
+    uint32_t _liveHighWater = 0;
+    uint32_t _latency[LATENCY_BUCKETS] = {0};
+    uint32_t _latencyCount = 0;
+    uint32_t _heapLowWater = 0;
+    uint32_t _lastAnswers = 0;
+    uint32_t _lastErrors = 0;
+    static uint32_t (*_heapProbe)();
+};
+
+}  // namespace vitoconnect
+}  // namespace esphome
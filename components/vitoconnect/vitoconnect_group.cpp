@@ -0,0 +1,95 @@
+/*
+  vitoconnect_group.cpp - Datapoints read back-to-back and published together
+
+  Copyright (C) 2026  vitoconnect contributors
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "vitoconnect_group.h"
+
+#include <algorithm>
+
+namespace esphome {
+namespace vitoconnect {
+
+static const char *TAG = "vitoconnect.group";
+
+void DatapointGroup::add_datapoint(Datapoint *datapoint) {
+  datapoint->setGroup(this);
+  this->_datapoints.push_back(datapoint);
+}
+
+void DatapointGroup::buildBlocks() {
+  std::sort(_datapoints.begin(), _datapoints.end(), [](Datapoint* a, Datapoint* b) {
+    return a->getAddress() < b->getAddress();
+  });
+  _datapoints.shrink_to_fit();
+
+  _blocks.clear();
+  for (uint8_t i = 0; i < _datapoints.size(); ++i) {
+    Datapoint* dp = _datapoints[i];
+    uint32_t end = dp->getAddress() + dp->getLength();
+    if (!_blocks.empty()) {
+      DatapointBlock& block = _blocks.back();
+      // merge into the previous block if the combined range still fits into one request
+      // and does not read more than max_gap unconfigured bytes in between
+      if (dp->getAddress() <= block.address + block.length + _maxGap &&
+          end - block.address <= MAX_DP_LENGTH) {
+        block.length = std::max<uint32_t>(block.length, end - block.address);
+        ++block.count;
+        continue;
+      }
+    }
+    _blocks.push_back({dp->getAddress(), dp->getLength(), i, 1});
+  }
+  _blocks.shrink_to_fit();
+  _ready.reserve(_datapoints.size());
+
+  ESP_LOGD(TAG, "Group with %zu datapoints is read in %zu block(s)", _datapoints.size(), _blocks.size());
+}
+
+uint8_t DatapointGroup::getRangeLength(uint8_t first, uint8_t count) {
+  uint32_t end = 0;
+  for (uint8_t i = first; i < first + count; ++i) {
+    end = std::max<uint32_t>(end, _datapoints[i]->getAddress() + _datapoints[i]->getLength());
+  }
+  return end - _datapoints[first]->getAddress();
+}
+
+bool DatapointGroup::membersReceived(uint8_t first, uint8_t count) {
+  for (uint8_t i = first; i < first + count; ++i) {
+    _ready.push_back(_datapoints[i]);
+  }
+  return --_pending == 0;
+}
+
+bool DatapointGroup::blockFailed() {
+  return --_pending == 0;
+}
+
+void DatapointGroup::publish() {
+  _timestamp = _completedAt;
+  _complete = false;
+  for (Datapoint* dp : _ready) {
+    dp->setLastRead(_timestamp);
+    if (dp->getLastUpdate() == 0) {  // do not overwrite a pending write
+      dp->decodeRaw();
+    }
+  }
+  _ready.clear();
+}
+
+}  // namespace vitoconnect
+}  // namespace esphome
@@ -0,0 +1,132 @@
+/*
+  vitoconnect_group.h - Datapoints read back-to-back and published together
+
+  Copyright (C) 2026  vitoconnect contributors
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <vector>
+
+#include "vitoconnect_optolink.h"
+#include "vitoconnect_datapoint.h"
+
+namespace esphome {
+namespace vitoconnect {
+
+/**
+ * @brief Contiguous address range that is read with a single request.
+ */
+struct DatapointBlock {
+  uint16_t address;  //!< Address of the first byte of the block
+  uint8_t length;    //!< Number of bytes covered by the block
+  uint8_t first;     //!< Index of the first member in the sorted datapoint list
+  uint8_t count;     //!< Number of members covered by the block
+};
+
+/**
+ * @brief Set of datapoints that are read back-to-back and published together.
+ *
+ * Members are sorted by address and merged into block reads of at most
+ * MAX_DP_LENGTH bytes where possible. Decoding is deferred until all blocks
+ * of the group have been answered, so all members share the same timestamp.
+ */
+class DatapointGroup {
+  public:
+    void add_datapoint(Datapoint *datapoint);
+
+    /**
+     * @brief Sort the members by address and merge them into blocks.
+     */
+    void buildBlocks();
+
+    /**
+     * @brief Number of unconfigured bytes that may be read in between two
+     *        members to merge them into one block, 0 merges only adjacent
+     *        or overlapping members. Must be set before buildBlocks().
+     */
+    void set_max_gap(uint8_t gap) { this->_maxGap = gap; }
+
+    const std::vector<DatapointBlock>& getBlocks() { return this->_blocks; }
+    const std::vector<Datapoint*>& getDatapoints() { return this->_datapoints; }
+
+    /**
+     * @brief Start a new read of the group.
+     */
+    void beginRead() { this->_pending = 0; this->_complete = false; this->_ready.clear(); }
+    void addPending() { ++this->_pending; }
+    bool isReading() { return this->_pending > 0 || this->_complete; }
+
+    /**
+     * @brief Number of bytes covered by count members starting at index first.
+     */
+    uint8_t getRangeLength(uint8_t first, uint8_t count);
+
+    /**
+     * @brief Mark count members starting at index first as received. A block
+     *        is read as a whole, in runs around members that are backing off,
+     *        or member by member after it was rejected by the device.
+     *
+     * @return true All requests of the group have been answered.
+     */
+    bool membersReceived(uint8_t first, uint8_t count);
+
+    /**
+     * @brief Mark a request as failed, its members will not be published.
+     *
+     * @return true All requests of the group have been answered.
+     */
+    bool blockFailed();
+
+    /**
+     * @brief Mark the read as complete, the members are published later on
+     *        with the given timestamp.
+     */
+    void markComplete(uint32_t timestamp) { this->_complete = true; this->_completedAt = timestamp; }
+    bool isComplete() { return this->_complete; }
+    uint8_t getReadyCount() { return this->_ready.size(); }
+
+    /**
+     * @brief Decode all received members and stamp them with the shared timestamp.
+     */
+    void publish();
+
+    /**
+     * @brief Time (millis) at which the group was last published.
+     */
+    uint32_t getTimestamp() { return this->_timestamp; }
+
+    /**
+     * @brief Minimum time (ms) between two reads of the group, 0 reads in
+     *        every polling cycle. May be changed at runtime.
+     */
+    void setPollInterval(uint32_t interval) { this->_pollInterval = interval; }
+    uint32_t getPollInterval() { return this->_pollInterval; }
+
+  private:
+    std::vector<Datapoint*> _datapoints;
+    std::vector<Datapoint*> _ready;
+    std::vector<DatapointBlock> _blocks;
+    uint8_t _pending = 0;
+    bool _complete = false;
+    uint32_t _completedAt = 0;
+    uint32_t _timestamp = 0;
+    uint32_t _pollInterval = 0;
+    uint8_t _maxGap = 0;
+};
+
+}  // namespace vitoconnect
+}  // namespace esphome
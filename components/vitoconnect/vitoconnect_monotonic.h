@@ -0,0 +1,78 @@
+/*
+  vitoconnect_monotonic.h - Monotonic clock used for all timing, with a virtual clock for simulation
+
+  Copyright (C) 2026  vitoconnect contributors
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include "esphome/core/hal.h"
+
+namespace esphome {
+namespace vitoconnect {
+
+/**
+ * @brief Millisecond clock used for protocol timeouts and scheduling.
+ *
+ * The hub passes its clock down to the optolink and all datapoints. On the
+ * target this is SystemClock (millis()), a host build can inject a virtual
+ * clock to drive the timing paths.
+ */
+class MonotonicClock {
+ public:
+  virtual ~MonotonicClock() {}
+  virtual uint32_t now() = 0;
+
+  /**
+   * @brief Microseconds for short measurements, wraps after about 71 minutes.
+   */
+  virtual uint32_t micros() = 0;
+};
+
+class SystemClock : public MonotonicClock {
+ public:
+  uint32_t now() override { return millis(); }
+  uint32_t micros() override { return esphome::micros(); }
+
+  static SystemClock* instance() {
+    static SystemClock clock;
+    return &clock;
+  }
+};
+
+/**
+ * @brief Clock that only moves when told to, for host builds and tests.
+ *
+ * Starts at 1 ms since 0 marks "never" in several timestamps.
+ */
+class VirtualClock : public MonotonicClock {
+ public:
+  explicit VirtualClock(uint32_t start = 1) : _micros((uint64_t) start * 1000) {}
+
+  uint32_t now() override { return _micros / 1000; }
+  uint32_t micros() override { return _micros; }
+
+  void advance(uint32_t ms) { _micros += (uint64_t) ms * 1000; }
+  void advanceMicros(uint32_t us) { _micros += us; }
+
+ private:
+  uint64_t _micros;
+};
+
+}  // namespace vitoconnect
+}  // namespace esphome
@@ -28,11 +28,40 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 namespace esphome {
 namespace vitoconnect {
 
+const char* optolinkErrorToString(uint8_t error) {
+  switch (error) {
+  case TIMEOUT:
+    return "TIMEOUT";
+  case LENGTH:
+    return "LENGTH";
+  case NACK:
+    return "NACK";
+  case CRC:
+    return "CRC";
+  case VITO_ERROR:
+    return "VITO_ERROR";
+  case MISMATCH:
+    return "MISMATCH";
+  case VERIFICATION:
+    return "VERIFICATION";
+  default:
+    return "UNKNOWN";
+  }
+}
+
 Optolink::Optolink(uart::UARTDevice* uart) :
   _uart(uart),
   _queue(VITOWIFI_MAX_QUEUE_LENGTH),
   _onData(nullptr),
-  _onError(nullptr) {}
+  _onError(nullptr),
+  _stallCount(0),
+  _clock(SystemClock::instance()),
+  _queueHighWater(0),
+  _retries(0),
+  _onTrace(nullptr),
+  _traceArg(nullptr),
+  _traceLen(0),
+  _traceTime(0) {}
 
 Optolink::~Optolink() {
   // nothing to do
@@ -56,22 +85,66 @@ void Optolink::onError(OnErrorArgCallback callback) {
 
 bool Optolink::read(uint16_t address, uint8_t length, void* arg) {
   OptolinkDP dp(address, length, false, nullptr, arg);
-  return _queue.push(dp);
+  if (!_queue.push(dp)) return false;
+  if (_queue.size() > _queueHighWater) _queueHighWater = _queue.size();
+  return true;
 }
 
 bool Optolink::write(uint16_t address, uint8_t length, uint8_t* data, void* arg) {
   OptolinkDP dp(address, length, true, data, arg);
-  return _queue.push(dp);
+  if (!_queue.push(dp)) return false;
+  if (_queue.size() > _queueHighWater) _queueHighWater = _queue.size();
+  return true;
 }
 
 void Optolink::_tryOnData(uint8_t* data, uint8_t len) {
+  _flushTrace();
   if (_onData) _onData(data, len, _queue.front()->arg);
   _queue.pop();
+  _retries = 0;
+}
+
+void Optolink::onTrace(OnTraceCallback callback, void* arg) {
+  _onTrace = callback;
+  _traceArg = arg;
 }
 
 void Optolink::_tryOnError(uint8_t error) {
+  _flushTrace();
   if (_onError) _onError(error, _queue.front()->arg);
   _queue.pop();
+  _retries = 0;
+}
+
+void Optolink::_clearRx() {
+  while (_uart->available()) {
+    _rxByte();
+  }
+}
+
+void Optolink::_txFrame(const uint8_t* data, uint8_t length) {
+  if (_onTrace) {
+    _flushTrace();
+    _onTrace(true, data, length, _clock->now(), _traceArg);
+  }
+  _uart->write_array(data, length);
+}
+
+uint8_t Optolink::_rxByte() {
+  uint8_t byte = _uart->read();
+  if (_onTrace) {
+    if (_traceLen == 0) _traceTime = _clock->now();
+    _traceBuffer[_traceLen++] = byte;
+    if (_traceLen == sizeof(_traceBuffer)) _flushTrace();
+  }
+  return byte;
+}
+
+void Optolink::_flushTrace() {
+  if (_onTrace && _traceLen > 0) {
+    _onTrace(false, _traceBuffer, _traceLen, _traceTime, _traceArg);
+  }
+  _traceLen = 0;
 }
 
 }  // namespace vitoconnect
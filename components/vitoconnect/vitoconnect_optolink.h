@@ -68,6 +68,12 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
    */
   #define VITOWIFI_MAX_QUEUE_LENGTH 64
 #endif
+#ifndef MAX_RETRIES
+  /** @brief Maximum number of times a request is sent again after a
+   *         discarded answer
+   */
+  #define MAX_RETRIES 2
+#endif
 #ifndef MAX_DP_LENGTH
   /** @brief Maximum size in bytes of a datapoint
    */
@@ -79,6 +85,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "vitoconnect_simpleQueue.h"
 #include "vitoconnect_optolinkDP.h"
+#include "vitoconnect_monotonic.h"
 
 namespace esphome {
 namespace vitoconnect {
@@ -91,11 +98,19 @@ enum OptolinkError : uint8_t {
   LENGTH,     ///< Received message length differs from expected length
   NACK,       ///< Message was nacked by Vitotronic
   CRC,        ///< Checksum failed (only for P300)
-  VITO_ERROR  ///< General error
+  VITO_ERROR, ///< General error
+  MISMATCH,   ///< Answers did not belong to the request, even after retrying (only for P300)
+  VERIFICATION ///< Write transaction failed, reported for all of its datapoints
 };
 
+/**
+ * @brief Human readable name of an OptolinkError.
+ */
+const char* optolinkErrorToString(uint8_t error);
+
 typedef void (*OnDataArgCallback)(uint8_t* data, uint8_t len, void* arg);
 typedef void (*OnErrorArgCallback)(uint8_t error, void* arg);
+typedef void (*OnTraceCallback)(bool tx, const uint8_t* data, uint8_t len, uint32_t timestamp, void* arg);
 
 /**
  * @brief Base class for the Optolink.
@@ -187,14 +202,64 @@ class Optolink {
    */
   virtual void loop() = 0;
 
+  /**
+   * @brief Number of requests waiting in the queue (including the one
+   *        currently being processed).
+   */
+  size_t queueSize() const { return _queue.size(); }
+
+  /**
+   * @brief Number of requests that can still be queued.
+   */
+  size_t queueAvailable() const { return _queue.available(); }
+
+  /**
+   * @brief Maximum number of requests that were waiting in the queue.
+   */
+  size_t getQueueHighWater() const { return _queueHighWater; }
+
+  /**
+   * @brief Number of times the watchdog had to restart a stalled link.
+   */
+  uint32_t getStallCount() const { return _stallCount; }
+
+  /**
+   * @brief Clock for all timeouts of the protocol, defaults to millis().
+   */
+  void setClock(MonotonicClock* clock) { _clock = clock; }
+
+  /**
+   * @brief Set a callback receiving all bytes on the wire (eg. to record
+   *        traces). Sent frames are passed as a whole, received bytes are
+   *        collected until the next transmission or the end of a request.
+   *
+   * @param callback Function with signature
+   *                 `void (bool tx, const uint8_t* data, uint8_t len, uint32_t timestamp, void* arg)`
+   * @param arg Pointer passed to the callback.
+   */
+  void onTrace(OnTraceCallback callback, void* arg = nullptr);
+
 
  protected:
   void _tryOnData(uint8_t* data, uint8_t len);
   void _tryOnError(uint8_t error);
+  void _clearRx();
+  void _txFrame(const uint8_t* data, uint8_t length);
+  uint8_t _rxByte();
+  void _flushTrace();
   uart::UARTDevice* _uart;
   SimpleQueue<OptolinkDP> _queue;  // TODO(bertmelis): add semaphore to ESP32 version to guard access to queue
   OnDataArgCallback _onData;
   OnErrorArgCallback _onError;
+  uint32_t _stallCount;
+  MonotonicClock* _clock;
+  size_t _queueHighWater;
+  uint8_t _retries;
+  OnTraceCallback _onTrace;
+  void* _traceArg;
+  uint8_t _traceBuffer[MAX_DP_LENGTH + 8];
+  uint8_t _traceLen;
+  uint32_t _traceTime;
 };
 
 }  // namespace vitoconnect
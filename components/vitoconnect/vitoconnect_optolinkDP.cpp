@@ -59,6 +59,22 @@ OptolinkDP::OptolinkDP(const OptolinkDP& obj) {
   }
 }
 
+OptolinkDP& OptolinkDP::operator=(const OptolinkDP& obj) {
+  if (this != &obj) {
+    if (data) delete[] data;
+    address = obj.address;
+    length = obj.length;
+    write = obj.write;
+    data = nullptr;
+    arg = obj.arg;
+    if (write) {
+      data = new uint8_t[length];
+      memcpy(data, obj.data, length);
+    }
+  }
+  return *this;
+}
+
 OptolinkDP::~OptolinkDP() {
   if (data) delete[] data;
 }
@@ -72,6 +72,16 @@ class OptolinkDP {
    */
   OptolinkDP(const OptolinkDP& obj);
 
+  /**
+   * @brief Copy assignment operator for the OptolinkDP class.
+   * 
+   * The queue assigns elements into its buffer, so the data has to be
+   * copied as well.
+   * 
+   * @param obj Object to be copied.
+   */
+  OptolinkDP& operator=(const OptolinkDP& obj);
+
   /**
    * @brief Destroy the OptolinkDP object
    * 
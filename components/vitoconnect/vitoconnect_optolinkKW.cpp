@@ -25,11 +25,23 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "vitoconnect_optolinkKW.h"
 
+#include <cinttypes>
+
 namespace esphome {
 namespace vitoconnect {
 
 static const char *TAG = "vitoconnect";
 
+// maximum time (ms) the protocol may stay in a state without progress, 0 = not watched
+static const uint32_t STATE_TIMEOUT[] = {
+  3000,  // INIT, sends a reset on its own every second
+  0,     // IDLE, falls back to INIT on its own after 5 seconds
+  1000,  // SYNC
+  1000,  // SEND
+  3000,  // RECEIVE, falls back to INIT on its own after 1 second
+  0      // UNDEF, begin() not called
+};
+
 OptolinkKW::OptolinkKW(uart::UARTDevice* uart) :
   Optolink(uart),
   _state(UNDEF),
@@ -64,12 +76,26 @@ void OptolinkKW::loop() {
     // begin() not called
     break;
   }
-  if (_queue.size() > 0 && millis() - _lastMillis > 5000UL) {  // if no ACK is coming, reset connection
+  _watchdog();
+}
+
+void OptolinkKW::_watchdog() {
+  uint32_t timeout = STATE_TIMEOUT[_state];
+  if (timeout == 0 || _clock->now() - _lastMillis <= timeout) {
+    return;
+  }
+
+  ++_stallCount;
+  ESP_LOGW(TAG, "KW stalled in state %d for %" PRIu32 " ms (queue %zu, rx %zu/%zu bytes, stalls %" PRIu32 "), restarting link",
+           _state, _clock->now() - _lastMillis, _queue.size(), _rcvBufferLen, _rcvLen, _stallCount);
+
+  // fail the request which is currently on the wire
+  if (_queue.size() > 0 && (_state == SEND || _state == RECEIVE)) {
     _tryOnError(TIMEOUT);
-    _state = INIT;
-    _uart->flush();
   }
-  // TODO(@bertmelis): move timeouts here, clear queue on timeout
+  _clearRx();
+  _lastMillis = _clock->now();
+  _state = INIT;
 }
 
 void OptolinkKW::_init() {
@@ -78,21 +104,21 @@ void OptolinkKW::_init() {
       _state = IDLE;
       _idle();
     } else {
-      _uart->read();
+      _rxByte();
     }
   } else {
-    if (millis() - _lastMillis > 1000UL) {  // try to reset if Vitotronic is in a connected state with the P300 protocol
-      _lastMillis = millis();
+    if (_clock->now() - _lastMillis > 1000UL) {  // try to reset if Vitotronic is in a connected state with the P300 protocol
+      _lastMillis = _clock->now();
       const uint8_t buff[] = {0x04};
-      _uart->write_array(buff, sizeof(buff));
+      _txFrame(buff, sizeof(buff));
     }
   }
 }
 
 void OptolinkKW::_idle() {
   if (_uart->available()) {
-    if (_uart->read() == 0x05) {
-      _lastMillis = millis();
+    if (_rxByte() == 0x05) {
+      _lastMillis = _clock->now();
       if (_queue.size() > 0) {
         _state = SYNC;
       }
@@ -100,17 +126,18 @@ void OptolinkKW::_idle() {
       ESP_LOGD(TAG, "Received unexpected data");
       // received something unexpected
     }
-  } else if ((_queue.size() > 0) && (millis() - _lastMillis < 10UL)) {  // don't wait for 0x05 sync signal, send directly after last request
+  } else if ((_queue.size() > 0) && (_clock->now() - _lastMillis < 10UL)) {  // don't wait for 0x05 sync signal, send directly after last request
     _state = SEND;
     _send();
-  } else if (millis() - _lastMillis > 5 * 1000UL) {
+  } else if (_clock->now() - _lastMillis > 5 * 1000UL) {
+    _lastMillis = _clock->now();  // the watchdog times the new state from here
     _state = INIT;
   }
 }
 
 void OptolinkKW::_sync() {
   const uint8_t buff[1] = {0x01};
-  _uart->write_array(buff, sizeof(buff));
+  _txFrame(buff, sizeof(buff));
   _state = SEND;
   _send();
 }
@@ -120,6 +147,7 @@ void OptolinkKW::_send() {
   OptolinkDP* dp = _queue.front();
   uint8_t length = dp->length;
   uint16_t address = dp->address;
+  _clearRx();  // drop leftovers (eg. sync bytes), the answer must only contain bytes sent after the request
   if (dp->write) {
     // type is WRITE, has length of 4 chars + length of value
     buff[0] = 0xF4;
@@ -129,7 +157,7 @@ void OptolinkKW::_send() {
     // add value to message
     memcpy(&buff[4], dp->data, length);
     _rcvLen = 1;  // expected answer length is only ACK (0x00)
-    _uart->write_array(buff, 4 + length);
+    _txFrame(buff, 4 + length);
   } else {
     // type is READ
     // has fixed length of 4 chars
@@ -138,28 +166,56 @@ void OptolinkKW::_send() {
     buff[2] = address & 0xFF;
     buff[3] = length;
     _rcvLen = length;  // expected answer length is requested length
-    _uart->write_array(buff, 4);
+    _txFrame(buff, 4);
   }
   _rcvBufferLen = 0;
-  _lastMillis = millis();
+  _lastMillis = _clock->now();
   _state = RECEIVE;
 }
 
 void OptolinkKW::_receive() {
-  while (_uart->available() != 0) {  // read complete RX buffer
-    _rcvBuffer[_rcvBufferLen] = _uart->read();
+  // read one byte more than expected to detect a stray sync byte in front of the answer
+  while (_uart->available() != 0 && _rcvBufferLen <= _rcvLen) {
+    _rcvBuffer[_rcvBufferLen] = _rxByte();
     ++_rcvBufferLen;
-    _lastMillis = millis();
+    _lastMillis = _clock->now();
   }
-  if (_rcvBufferLen == _rcvLen) {  // message complete, TODO: check message (eg 0x00 for READ messages)   
+  if (_rcvBufferLen > _rcvLen && _rcvBuffer[0] == 0x05) {
+    ESP_LOGD(TAG, "Dropping sync byte in front of the answer");
+    memmove(_rcvBuffer, &_rcvBuffer[1], --_rcvBufferLen);
+  }
+  if (_rcvBufferLen > _rcvLen) {  // answer is longer than expected, framing is lost
+    ESP_LOGD(TAG, "Received more than the expected length %zu", _rcvLen);
+    _tryOnError(LENGTH);
+    _clearRx();
+    _rcvBufferLen = 0;
+    _state = INIT;
+    return;
+  }
+  if (_rcvBufferLen == _rcvLen) {  // message complete, check message
+    if (_rcvBuffer[0] == 0x05 && _clock->now() - _lastMillis < 10UL) {
+      // could be a sync byte sent right before the answer, wait whether another byte follows
+      return;
+    }
     OptolinkDP* dp = _queue.front();
-    ESP_LOGD(TAG, "Adding data to datapoint with address %x and received length %d", dp->address, _rcvBufferLen);
-    _tryOnData(_rcvBuffer, _rcvBufferLen);
+    if (dp->write) {
+      if (_rcvBuffer[0] == 0x00) {  // write is acknowledged with 0x00
+        ESP_LOGD(TAG, "Write to datapoint with address %x acknowledged", dp->address);
+        _tryOnData(dp->data, dp->length);
+      } else {
+        ESP_LOGD(TAG, "Write to datapoint with address %x not acknowledged: %02x", dp->address, _rcvBuffer[0]);
+        _tryOnError(NACK);
+      }
+    } else {
+      ESP_LOGD(TAG, "Adding data to datapoint with address %x and received length %zu", dp->address, _rcvBufferLen);
+      _tryOnData(_rcvBuffer, _rcvBufferLen);
+    }
     _state = IDLE;
-    _lastMillis = millis();
+    _lastMillis = _clock->now();
     return;
-  } else if (millis() - _lastMillis > 1 * 1000UL) {  // Vitotronic isn't answering, try again
-    ESP_LOGD(TAG, "Received length %d doesn't match expected length %d", _rcvBufferLen, _rcvLen);
+  } else if (_clock->now() - _lastMillis > 1 * 1000UL) {  // Vitotronic isn't answering, try again
+    ESP_LOGD(TAG, "Received length %zu doesn't match expected length %zu", _rcvBufferLen, _rcvLen);
+    _tryOnError(TIMEOUT);
     _rcvBufferLen = 0;
     memset(_rcvBuffer, 0, 4);
     _state = INIT;
@@ -84,9 +84,10 @@ class OptolinkKW : public Optolink {
   void _sync();
   void _send();
   void _receive();
+  void _watchdog();
   uint32_t _lastMillis;
   bool _write;
-  uint8_t _rcvBuffer[MAX_DP_LENGTH];
+  uint8_t _rcvBuffer[MAX_DP_LENGTH + 1];
   size_t _rcvBufferLen;
   size_t _rcvLen;
 };
@@ -25,12 +25,28 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "vitoconnect_optolinkP300.h"
 
+#include <cinttypes>
+
 namespace esphome {
 namespace vitoconnect {
 
 static const char *TAG = "vitoconnect";
 
-inline uint8_t calcChecksum(uint8_t array[], uint8_t length) {
+// maximum time (ms) the protocol may stay in a state without progress, 0 = not watched
+static const uint32_t STATE_TIMEOUT[] = {
+  1000,  // RESET
+  3000,  // RESET_ACK, retries on its own every second
+  1000,  // INIT
+  2000,  // INIT_ACK
+  0,     // IDLE, sends INIT on its own every 5 seconds
+  1000,  // SEND
+  3000,  // SEND_ACK
+  3000,  // RECEIVE
+  1000,  // RECEIVE_ACK
+  0      // UNDEF, begin() not called
+};
+
+uint8_t OptolinkP300::calcChecksum(const uint8_t* array, uint8_t length) {
   uint8_t sum = 0;
   for (uint8_t i = 1; i < length - 1; ++i) {  // start with second byte and end before checksum
     sum += array[i];
@@ -39,7 +55,7 @@ inline uint8_t calcChecksum(uint8_t array[], uint8_t length) {
 }
 
 inline bool checkChecksum(uint8_t array[], uint8_t length) {
-  return (array[length - 1] == calcChecksum(array, length));
+  return (array[length - 1] == OptolinkP300::calcChecksum(array, length));
 }
 
 OptolinkP300::OptolinkP300(uart::UARTDevice* uart) :
@@ -88,29 +104,42 @@ void OptolinkP300::loop() {
     // begin() not called
     break;
   }
-  if (_queue.size() > 0 && millis() - _lastMillis > 5000UL) {  // if no ACK is coming, reset connection
+  _watchdog();
+}
+
+void OptolinkP300::_watchdog() {
+  uint32_t timeout = STATE_TIMEOUT[_state];
+  if (timeout == 0 || _clock->now() - _lastMillis <= timeout) {
+    return;
+  }
+
+  ++_stallCount;
+  ESP_LOGW(TAG, "P300 stalled in state %d for %" PRIu32 " ms (queue %zu, rx %zu/%zu bytes, stalls %" PRIu32 "), restarting link",
+           _state, _clock->now() - _lastMillis, _queue.size(), _rcvBufferLen, _rcvLen, _stallCount);
+
+  // fail the request which is currently on the wire
+  if (_queue.size() > 0 && (_state == SEND || _state == SEND_ACK || _state == RECEIVE)) {
     _tryOnError(TIMEOUT);
-    _state = RESET;
-    _uart->flush();
   }
-  // TODO(@bertmelis): move timeouts here, clear queue on timeout
+  _clearRx();
+  _state = RESET;
 }
 
 void OptolinkP300::_reset() {
   // Set communication with Vitotronic to defined state = reset to KW protocol
   const uint8_t buff[] = {0x04};
-  _uart->write_array(buff, sizeof(buff));
-  _lastMillis = millis();
+  _txFrame(buff, sizeof(buff));
+  _lastMillis = _clock->now();
   _state = RESET_ACK;
 }
 
 void OptolinkP300::_resetAck() {
-  if (_uart->read() == 0x05) {
+  if (_uart->available() && _rxByte() == 0x05) {
     // received 0x05/enquiry: optolink has been reset
-    _lastMillis = millis();
+    _lastMillis = _clock->now();
     _state = INIT;
   } else {
-    if (millis() - _lastMillis > 1000) {  // try again every 0,5sec
+    if (_clock->now() - _lastMillis > 1000) {  // try again every 0,5sec
       _state = RESET;
     }
   }
@@ -118,16 +147,16 @@ void OptolinkP300::_resetAck() {
 
 void OptolinkP300::_init() {
   const uint8_t buff[] = {0x16, 0x00, 0x00};
-  _uart->write_array(buff, sizeof(buff));
-  _lastMillis = millis();
+  _txFrame(buff, sizeof(buff));
+  _lastMillis = _clock->now();
   _state = INIT_ACK;
 }
 
 void OptolinkP300::_initAck() {
   if (_uart->available()) {
-    if (_uart->read() == 0x06) {
+    if (_rxByte() == 0x06) {
       // ACK received, moving to next state
-      _lastMillis = millis();
+      _lastMillis = _clock->now();
       _state = IDLE;
     }
   }
@@ -135,20 +164,20 @@ void OptolinkP300::_initAck() {
 
 void OptolinkP300::_idle() {
   // send INIT every 5 seconds to keep communication alive
-  if (millis() - _lastMillis > 5 * 1000UL) {
+  if (_clock->now() - _lastMillis > 5 * 1000UL) {
+    _lastMillis = _clock->now();  // the watchdog times the new state from here
     _state = INIT;
   }
   if (_queue.size() > 0) {
+    _lastMillis = _clock->now();
     _state = SEND;
   }
 }
 
-void OptolinkP300::_send() {
-  uint8_t buff[MAX_DP_LENGTH + 8];
-  OptolinkDP* dp = _queue.front();
-  uint8_t length = dp->length;
-  uint16_t address = dp->address;
-  if (dp->write) {
+uint8_t OptolinkP300::buildFrame(uint8_t* buff, const OptolinkDP& dp) {
+  uint8_t length = dp.length;
+  uint16_t address = dp.address;
+  if (dp.write) {
     // type is WRITE, has length of 8 chars + length of value
     buff[0] = 0x41;
     buff[1] = 5 + length;
@@ -158,33 +187,41 @@ void OptolinkP300::_send() {
     buff[5] = address & 0xFF;
     buff[6] = length;
     // add value to message
-    memcpy(&buff[7], dp->data, length);
+    memcpy(&buff[7], dp.data, length);
     buff[7 + length] = calcChecksum(buff, 8 + length);
-    _uart->write_array(buff, 8 + length);
+    return 8 + length;
+  }
+  // type is READ
+  // has fixed length of 8 chars
+  buff[0] = 0x41;
+  buff[1] = 0x05;
+  buff[2] = 0x00;
+  buff[3] = 0x01;
+  buff[4] = (address >> 8) & 0xFF;
+  buff[5] = address & 0xFF;
+  buff[6] = length;
+  buff[7] = calcChecksum(buff, 8);
+  return 8;
+}
+
+void OptolinkP300::_send() {
+  uint8_t buff[MAX_DP_LENGTH + 8];
+  OptolinkDP* dp = _queue.front();
+  _txFrame(buff, buildFrame(buff, *dp));
+  if (dp->write) {
     _rcvLen = 8;  // Written payload is not returned, the return length is
                   // always 8 bytes long
   } else {
-    // type is READ
-    // has fixed length of 8 chars
-    buff[0] = 0x41;
-    buff[1] = 0x05;
-    buff[2] = 0x00;
-    buff[3] = 0x01;
-    buff[4] = (address >> 8) & 0xFF;
-    buff[5] = address & 0xFF;
-    buff[6] = length;
-    buff[7] = calcChecksum(buff, 8);
-    _rcvLen = 8 + length;  // expected answer length is 8 + data length
-    _uart->write_array(buff, 8);
+    _rcvLen = 8 + dp->length;  // expected answer length is 8 + data length
   }
   _rcvBufferLen = 0;
-  _lastMillis = millis();
+  _lastMillis = _clock->now();
   _state = SEND_ACK;
 }
 
 void OptolinkP300::_sentAck() {
   if (_uart->available()) {
-    uint8_t buff = _uart->read();
+    uint8_t buff = _rxByte();
     if (buff == 0x06) {  // transmit successful, moving to next state
       _state = RECEIVE;
       return;
@@ -198,55 +235,75 @@ void OptolinkP300::_sentAck() {
 }
 
 void OptolinkP300::_receive() {
-  while (_uart->available() != 0) {  // read complete RX buffer
-    _rcvBuffer[_rcvBufferLen] = _uart->read();
+  while (_uart->available() != 0) {  // read RX buffer until the frame is complete
+    uint8_t byte = _rxByte();
+    _lastMillis = _clock->now();
+    if (_rcvBufferLen == 0 && byte != 0x41) {
+      // wait for start byte
+      continue;
+    }
+    _rcvBuffer[_rcvBufferLen] = byte;
     ++_rcvBufferLen;
-    _lastMillis = millis();
+    if (_rcvBufferLen == sizeof(_rcvBuffer) || (_rcvBufferLen > 1 && _rcvBufferLen == _rcvBuffer[1] + 3u)) {
+      break;
+    }
   }
-  if (_rcvBuffer[0] != 0x41) {
-    // wait for start byte
+  if (_rcvBufferLen < 2 || (_rcvBufferLen < _rcvBuffer[1] + 3u && _rcvBufferLen < sizeof(_rcvBuffer))) {
+    // not yet complete
     return;
   }
-  // ESP_LOGD(TAG, "buffer fill: %02x", _rcvBuffer[_rcvBufferLen-1]);
-  // ESP_LOGD(TAG, "buffer fill: %d", _rcvBufferLen);
-  // ESP_LOGD(TAG, "buffer fill: %d", _rcvLen);
-  if (_rcvBufferLen == _rcvLen) {     // message complete, check message
-    if (_rcvBuffer[1] != (_rcvLen - 3)) {  // check for message length
-      _tryOnError(LENGTH);
-      _state = RECEIVE_ACK;
-      return;
-    }
-    if (_rcvBuffer[2] != 0x01) {  // Vitotronic returns an error message
-      _tryOnError(VITO_ERROR);
-      _state = RECEIVE_ACK;
-      return;
-    }
-    if (!checkChecksum(_rcvBuffer, _rcvLen)) {  // checksum is wrong
-      _tryOnError(CRC);
-      _state = RECEIVE_ACK;  // TODO(@bertmelis): should we return NACK?
-      return;
-    }
-    OptolinkDP* dp = _queue.front();
-    if (_rcvBuffer[3] == 0x01) {
-      // message is from READ command, so returning read value
-      _tryOnData(&_rcvBuffer[7], dp->length);
-    } else if (_rcvBuffer[3] == 0x03) {
-      // message is from WRITE command, so returning written value
-      _tryOnData(dp->data, dp->length);
-    } else {
-      // should not be here
+
+  size_t frameLen = _rcvBuffer[1] + 3;
+  if (frameLen < 8 || frameLen > sizeof(_rcvBuffer)) {  // shorter or longer than any answer we can expect
+    _tryOnError(LENGTH);
+    _clearRx();
+    _state = RECEIVE_ACK;
+    return;
+  }
+  if (!checkChecksum(_rcvBuffer, frameLen)) {  // checksum is wrong
+    _tryOnError(CRC);
+    _state = RECEIVE_ACK;  // TODO(@bertmelis): should we return NACK?
+    return;
+  }
+
+  // make sure the answer belongs to the request on the wire (eg. not a late answer after a resync)
+  OptolinkDP* dp = _queue.front();
+  uint16_t address = (_rcvBuffer[4] << 8) | _rcvBuffer[5];
+  if (_rcvBuffer[3] != (dp->write ? 0x02 : 0x01) || address != dp->address || _rcvBuffer[6] != dp->length) {
+    ESP_LOGW(TAG, "Discarding answer for address %x (length %d), expected %x (length %d)",
+             address, _rcvBuffer[6], dp->address, dp->length);
+    if (++_retries > MAX_RETRIES) {
+      _tryOnError(MISMATCH);
     }
+    // request stays in the queue and is sent again
+    _state = RECEIVE_ACK;
+    return;
+  }
+
+  if (_rcvBuffer[2] != 0x01) {  // Vitotronic returns an error message
+    _tryOnError(VITO_ERROR);
     _state = RECEIVE_ACK;
     return;
+  }
+  if (frameLen != _rcvLen) {  // check for message length
+    _tryOnError(LENGTH);
+    _state = RECEIVE_ACK;
+    return;
+  }
+  if (dp->write) {
+    // message is from WRITE command, so returning written value
+    _tryOnData(dp->data, dp->length);
   } else {
-    // not yet complete
+    // message is from READ command, so returning read value
+    _tryOnData(&_rcvBuffer[7], dp->length);
   }
+  _state = RECEIVE_ACK;
 }
 
 void OptolinkP300::_receiveAck() {
   const uint8_t buff[] = {0x06};
-  _uart->write_array(buff, sizeof(buff));
-  _lastMillis = millis();
+  _txFrame(buff, sizeof(buff));
+  _lastMillis = _clock->now();
   _state = IDLE;
 }
 
@@ -70,6 +70,21 @@ class OptolinkP300 : public Optolink {
    */
   void loop();
 
+  /**
+   * @brief Build the request frame for a datapoint.
+   *
+   * @param buff Buffer of at least MAX_DP_LENGTH + 8 bytes.
+   * @param dp Datapoint to read or write.
+   * @return uint8_t Length of the frame.
+   */
+  static uint8_t buildFrame(uint8_t* buff, const OptolinkDP& dp);
+
+  /**
+   * @brief Checksum of a frame: sum of all bytes between the start byte and
+   *        the checksum (last byte).
+   */
+  static uint8_t calcChecksum(const uint8_t* array, uint8_t length);
+
  private:
   enum OptolinkState : uint8_t {
     RESET = 0,
@@ -92,6 +107,7 @@ class OptolinkP300 : public Optolink {
   void _sentAck();
   void _receive();
   void _receiveAck();
+  void _watchdog();
   uint32_t _lastMillis;
   bool _write;
   uint8_t _rcvBuffer[MAX_DP_LENGTH + 8];
@@ -70,6 +70,20 @@ class SimpleQueue {
     }
   }
 
+  /**
+   * @brief Drop all elements and resize the queue.
+   * 
+   * @param size New maximum number of elements in the queue.
+   */
+  void reserve(size_t size) {
+    delete[] _buffer;
+    _buffer = new T[size];
+    _firstPosition = 0;
+    _nextPosition = 0;
+    _count = 0;
+    _size = size;
+  }
+
   /**
    * @brief Destroy the SimpleQueue object.
    * 
@@ -145,6 +159,15 @@ class SimpleQueue {
     return _count;
   }
 
+  /**
+   * @brief Return the number of elements that can still be added.
+   * 
+   * @return size_t number of free slots.
+   */
+  size_t available() const {
+    return _size - _count;
+  }
+
  private:
   T* _buffer;
   size_t _firstPosition;
@@ -0,0 +1,34 @@
+/*
+  bench.cpp - Host benchmark of the codec and frame building hot paths
+
+  Copyright (C) 2026  vitoconnect contributors
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Host benchmark of the codec and frame building hot paths, the cases are in
+  bench.h. tests/bench.yaml runs the same cases on an ESP in CPU cycles.
+
+    bench [iterations]   (default 1000000)
+*/
+
+#include <cstdlib>
+
+#include "bench.h"
+
+int main(int argc, char** argv) {
+  esphome::vitoconnect::bench::run(argc > 1 ? atoi(argv[1]) : 1000000);
+  return 0;
+}
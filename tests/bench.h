@@ -0,0 +1,174 @@
+/*
+  bench.h - Benchmark cases of the codec and frame building hot paths
+
+  Copyright (C) 2026  vitoconnect contributors
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Benchmark cases shared by the host benchmark (bench.cpp) and the on-target
+  run (bench.yaml). On an ESP every case is timed with the CPU cycle counter
+  and logged in cycles per call; on the host a steady clock gives ns per
+  call, which only compares two builds on the same machine.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+#if defined(USE_ESP32) || defined(USE_ESP8266)
+#include "esphome/core/log.h"
+#include "esphome/components/vitoconnect/vitoconnect_optolinkP300.h"
+#include "esphome/components/vitoconnect/number/vitoconnect_number.h"
+#include "esphome/components/vitoconnect/sensor/vitoconnect_sensor.h"
+#include "esphome/components/vitoconnect/switch/vitoconnect_switch.h"
+#else
+#include <chrono>
+#include <cstdio>
+#include "vitoconnect_optolinkP300.h"
+#include "number/vitoconnect_number.h"
+#include "sensor/vitoconnect_sensor.h"
+#include "switch/vitoconnect_switch.h"
+#endif
+
+#if defined(USE_ESP32)
+#include <esp_idf_version.h>
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+#include <esp_cpu.h>
+#else
+#include <hal/cpu_hal.h>
+#endif
+#elif defined(USE_ESP8266)
+#include <Esp.h>
+#endif
+
+namespace esphome {
+namespace vitoconnect {
+namespace bench {
+
+#if defined(USE_ESP32) || defined(USE_ESP8266)
+typedef uint32_t Ticks;  // the cycle counter wraps after some seconds at 240 MHz
+static const char* const UNIT = "cycles";
+#else
+typedef uint64_t Ticks;
+static const char* const UNIT = "ns";
+#endif
+
+// CPU cycles on an ESP, ns on the host
+inline Ticks ticks() {
+#if defined(USE_ESP32)
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+  return esp_cpu_get_cycle_count();
+#else
+  return cpu_hal_get_cycle_count();
+#endif
+#elif defined(USE_ESP8266)
+  return ESP.getCycleCount();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+inline void report(const std::string& name, double perCall) {
+#if defined(USE_ESP32) || defined(USE_ESP8266)
+  ESP_LOGI("vitoconnect.bench", "%-32s %8.1f %s/call", name.c_str(), perCall, UNIT);
+#else
+  printf("%-32s %8.1f %s/call\n", name.c_str(), perCall, UNIT);
+#endif
+}
+
+struct Runner {
+  uint32_t iterations;
+  volatile uint32_t sink = 0;  // keeps the results alive
+
+  template<class F> void operator()(const std::string& name, F body) {
+    for (uint32_t i = 0; i < iterations / 10; ++i) body(i);  // warm up
+    Ticks start = ticks();
+    for (uint32_t i = 0; i < iterations; ++i) body(i);
+    Ticks elapsed = ticks() - start;
+    report(name, (double) elapsed / iterations);
+  }
+};
+
+/**
+ * @brief Run every case. On an ESP keep the iterations low enough that a case
+ *        stays well below the wrap of the cycle counter and the task watchdog.
+ */
+inline void run(uint32_t iterations) {
+  Runner bench{iterations};
+  uint8_t raw[4] = {0};
+
+  for (uint8_t length : {1, 2, 4}) {
+    OPTOLINKSensor sensor;
+    sensor.setLength(length);
+    bench("sensor decode, length " + std::to_string(length), [&](uint32_t i) {
+      raw[0] = i;
+      sensor.decode(raw, length);
+      bench.sink += sensor.state;
+    });
+  }
+
+  for (uint32_t ratio : {1, 2, 10, 3600}) {
+    OPTOLINKNumber number;
+    number.setLength(2);
+    number.setDivRatio(ratio);
+    bench("number decode, div_ratio " + std::to_string(ratio), [&](uint32_t i) {
+      raw[0] = i;
+      number.decode(raw, 2);
+      bench.sink += number.state;
+    });
+    bench("number encode, div_ratio " + std::to_string(ratio), [&](uint32_t i) {
+      number.encode(raw, 2, (float) (i & 0xFF) / ratio);
+      bench.sink += raw[0];
+    });
+  }
+
+  OPTOLINKSwitch plain;
+  plain.setLength(1);
+  bench("switch encode", [&](uint32_t i) {
+    plain.encode(raw, 1, (bool) (i & 1));
+    bench.sink += raw[0];
+  });
+  OPTOLINKSwitch bit;
+  bit.setLength(1);
+  bit.setMask(0x08);
+  bench("switch encode, mask", [&](uint32_t i) {
+    bit.encode(raw, 1, (bool) (i & 1));
+    bench.sink += raw[0];
+  });
+
+  uint8_t frame[MAX_DP_LENGTH + 8] = {0x41, 0x05, 0x00, 0x01, 0x08, 0x00, 0x02};
+  bench("P300 checksum, read frame", [&](uint32_t i) {
+    frame[5] = i;
+    bench.sink += OptolinkP300::calcChecksum(frame, 8);
+  });
+
+  uint8_t value[4] = {0x12, 0x34, 0x56, 0x78};
+  OptolinkDP read(0x0800, 2, false, nullptr, nullptr);
+  OptolinkDP write(0x2000, 4, true, value, nullptr);
+  bench("P300 frame, read", [&](uint32_t i) {
+    read.address = i;
+    bench.sink += OptolinkP300::buildFrame(frame, read) + frame[7];
+  });
+  bench("P300 frame, write 4 bytes", [&](uint32_t i) {
+    write.address = i;
+    bench.sink += OptolinkP300::buildFrame(frame, write) + frame[11];
+  });
+}
+
+}  // namespace bench
+}  // namespace vitoconnect
+}  // namespace esphome
@@ -0,0 +1,64 @@
+/*
+  fake_uart.h - In-memory UART for the host tests
+
+  Copyright (C) 2026  vitoconnect contributors
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <deque>
+#include <vector>
+
+#include "esphome/components/uart/uart.h"
+
+namespace esphome {
+namespace vitoconnect {
+
+/**
+ * @brief UART bus of the host tests: records everything written and hands
+ *        out the bytes fed by the test or the simulated device.
+ */
+class FakeUart : public uart::UARTComponent {
+ public:
+  void write_array(const uint8_t* data, size_t len) override { tx.insert(tx.end(), data, data + len); }
+
+  bool peek_byte(uint8_t* data) override {
+    if (rx.empty()) return false;
+    *data = rx.front();
+    return true;
+  }
+
+  bool read_array(uint8_t* data, size_t len) override {
+    if (rx.size() < len) return false;
+    for (size_t i = 0; i < len; ++i) {
+      data[i] = rx.front();
+      rx.pop_front();
+    }
+    rxConsumed += len;
+    return true;
+  }
+
+  int available() override { return rx.size(); }
+
+  void feed(const std::vector<uint8_t>& bytes) { rx.insert(rx.end(), bytes.begin(), bytes.end()); }
+
+  std::deque<uint8_t> rx;   // waiting to be read by the optolink
+  std::vector<uint8_t> tx;  // everything the optolink has sent
+  size_t rxConsumed = 0;    // number of bytes the optolink has read
+};
+
+}  // namespace vitoconnect
+}  // namespace esphome
@@ -0,0 +1,377 @@
+/*
+  soak_test.cpp - Long running soak test against a simulated Vitotronic
+
+  Copyright (C) 2026  vitoconnect contributors
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Runs a hub with 200 datapoints against a simulated Vitotronic for weeks of
+  virtual time, with writes, line noise and device reboots, and checks that
+  nothing accumulates: live request contexts, heap and queue high-water
+  marks must stay bounded, and all entities must match the device at the end.
+  Latency and error rate are sampled per simulated day and must neither leave
+  their bounds nor trend upward once warmed up.
+
+    soak_test [days]   (default 21)
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+
+#include "vitoconnect.h"
+#include "number/vitoconnect_number.h"
+#include "sensor/vitoconnect_sensor.h"
+#include "switch/vitoconnect_switch.h"
+#include "fake_uart.h"
+#include "vitotronic_sim.h"
+
+using namespace esphome::vitoconnect;
+
+// heap accounting: every allocation carries its size in front of it
+static size_t heapInUse = 0;
+static const size_t HEAP_SIZE = 320 * 1024;  // roughly the free heap of an ESP32
+static const size_t HEAP_HEADER = 16;        // keeps the alignment of malloc
+
+void* operator new(size_t size) {
+  uint8_t* block = static_cast<uint8_t*>(malloc(size + HEAP_HEADER));
+  if (block == nullptr) throw std::bad_alloc();
+  *reinterpret_cast<size_t*>(block) = size;
+  heapInUse += size;
+  return block + HEAP_HEADER;
+}
+
+void operator delete(void* pointer) noexcept {
+  if (pointer == nullptr) return;
+  uint8_t* block = static_cast<uint8_t*>(pointer) - HEAP_HEADER;
+  heapInUse -= *reinterpret_cast<size_t*>(block);
+  free(block);
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete[](void* pointer) noexcept { operator delete(pointer); }
+void operator delete(void* pointer, size_t) noexcept { operator delete(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { operator delete(pointer); }
+
+static uint32_t freeHeap() { return HEAP_SIZE - heapInUse; }
+
+namespace {
+
+const uint32_t UPDATE_INTERVAL = 30 * 1000;
+const uint32_t MINUTE = 60 * 1000;
+const uint32_t HOUR = 60 * MINUTE;
+const uint32_t DAY = 24 * HOUR;
+
+// daily bounds: latency includes the wait in a queue of a whole cycle, which must
+// drain within the update interval; the line noise alone fails about one request in a hundred
+const uint32_t LATENCY_P50_MAX = 10000;
+const uint32_t LATENCY_P99_MAX = UPDATE_INTERVAL;
+const float ERROR_RATE_MAX = 0.05f;
+
+int failures = 0;
+
+struct DayStats {
+  uint32_t p50;  // upper bounds (ms) of the latency buckets
+  uint32_t p99;
+  float errorRate;  // errors per answer
+};
+
+float mean(const std::vector<DayStats>& stats, size_t from, size_t to, float DayStats::*field) {
+  float sum = 0.0f;
+  for (size_t i = from; i < to; ++i) sum += stats[i].*field;
+  return to > from ? sum / (to - from) : 0.0f;
+}
+
+void check(bool condition, const char* message) {
+  if (!condition) {
+    printf("FAILED: %s\n", message);
+    ++failures;
+  }
+}
+
+struct Soak {
+  VirtualClock clock;
+  FakeUart uart;
+  SimulatedVitotronic device{&uart, &clock, 42};
+  VitoConnect hub;
+  std::mt19937 engine{7};
+  uint32_t nextUpdate = 0;
+
+  std::vector<OPTOLINKSensor*> sensors;
+  std::vector<OPTOLINKSensor*> invalid;
+  std::vector<OPTOLINKNumber*> numbers;
+  std::vector<OPTOLINKSwitch*> switches;
+  size_t ungrouped = 0;
+
+  template<class T> T* add(uint16_t address, uint8_t length, DatapointGroup* group = nullptr, uint8_t mask = 0) {
+    T* entity = new T();
+    entity->setAddress(address);
+    entity->setLength(length);
+    entity->setMask(mask);
+    if (group) {
+      group->add_datapoint(entity);
+    } else {
+      ++ungrouped;
+    }
+    hub.register_datapoint(entity);
+    return entity;
+  }
+
+  DatapointGroup* group() {
+    DatapointGroup* group = new DatapointGroup();
+    hub.register_group(group);
+    return group;
+  }
+
+  uint32_t random(uint32_t min, uint32_t max) { return std::uniform_int_distribution<uint32_t>(min, max)(engine); }
+
+  void setup() {
+    // 80 temperatures in 8 groups of 10 neighbouring addresses
+    for (uint8_t g = 0; g < 8; ++g) {
+      DatapointGroup* circuit = group();
+      for (uint8_t i = 0; i < 10; ++i) sensors.push_back(add<OPTOLINKSensor>(0x0800 + g * 0x40 + i * 2, 2, circuit));
+    }
+    // 54 single values and counters, 2 addresses the device does not know
+    for (uint8_t i = 0; i < 54; ++i) sensors.push_back(add<OPTOLINKSensor>(0x2000 + i * 8, i % 3 == 0 ? 4 : i % 3 == 1 ? 2 : 1));
+    for (uint8_t i = 0; i < 2; ++i) {
+      invalid.push_back(add<OPTOLINKSensor>(0x7F00 + i * 2, 2));
+      device.setInvalid(0x7F00 + i * 2);
+    }
+    // a group with 2 more unknown addresses in between its members
+    DatapointGroup* mixed = group();
+    for (uint8_t i = 0; i < 4; ++i) {
+      OPTOLINKSensor* sensor = add<OPTOLINKSensor>(0x7E00 + i * 2, 2, mixed);
+      if (i % 2) {
+        invalid.push_back(sensor);
+        device.setInvalid(sensor->getAddress());
+      } else {
+        sensors.push_back(sensor);
+      }
+    }
+    // 36 settings, 8 of them 2-bit fields of two bytes, and 24 switches, 16 of them single bits
+    DatapointGroup* bits = group();
+    for (uint8_t i = 0; i < 28; ++i) numbers.push_back(add<OPTOLINKNumber>(0x3000 + i, 1));
+    for (uint8_t i = 0; i < 8; ++i) {
+      OPTOLINKNumber* field = add<OPTOLINKNumber>(0x3100 + i / 4, 1, bits, 0x03 << (i % 4 * 2));
+      field->traits.set_max_value(3);
+      numbers.push_back(field);
+    }
+    for (uint8_t i = 0; i < 16; ++i) switches.push_back(add<OPTOLINKSwitch>(0x3200 + i / 8, 1, bits, 1 << (i % 8)));
+    for (uint8_t i = 0; i < 8; ++i) switches.push_back(add<OPTOLINKSwitch>(0x3300 + i, 1));
+    for (Datapoint* dp : numbers) dp->setPollInterval(5 * MINUTE);
+    for (Datapoint* dp : switches) dp->setPollInterval(5 * MINUTE);
+
+    for (OPTOLINKSensor* sensor : sensors) {
+      for (uint8_t i = 0; i < sensor->getLength(); ++i) *device.memory(sensor->getAddress() + i) = random(0, 255);
+    }
+    for (OPTOLINKNumber* number : numbers) {
+      if (number->getMask() == 0) *device.memory(number->getAddress()) = random(0, 100);
+    }
+    for (uint8_t i = 0; i < 2; ++i) *device.memory(0x3100 + i) = random(0, 255);
+    for (uint8_t i = 0; i < 2; ++i) *device.memory(0x3200 + i) = random(0, 255);
+
+    hub.set_uart_parent(&uart);
+    hub.set_protocol("P300");
+    hub.set_clock(&clock);
+    hub.set_update_interval(UPDATE_INTERVAL);
+    hub.set_stale_factor(3);
+    hub.set_quarantine_after(5);
+    hub.set_reprobe_interval(HOUR);
+    hub.set_write_retries(3);
+    hub.setup();
+    nextUpdate = clock.now();
+  }
+
+  // run the main loop, in 1 ms steps while bytes are on the wire and larger ones otherwise
+  void run(uint32_t duration) {
+    uint32_t end = clock.now() + duration;
+    while ((int32_t) (end - clock.now()) > 0) {
+      if ((int32_t) (clock.now() - nextUpdate) >= 0) {
+        hub.update();
+        nextUpdate += UPDATE_INTERVAL;
+      }
+      hub.loop();
+      device.loop();
+
+      uint32_t step = hub.getDiagnostics().getLive() > 0 ? 10 : 100;
+      if (uart.available()) step = 1;
+      if (device.nextEvent() != UINT32_MAX) step = std::min<uint32_t>(step, std::max<int32_t>(device.nextEvent() - clock.now(), 1));
+      step = std::min<uint32_t>(step, std::max<int32_t>(nextUpdate - clock.now(), 1));
+      clock.advance(step);
+    }
+  }
+
+  void drift() {
+    for (uint8_t i = 0; i < 10; ++i) {
+      OPTOLINKSensor* sensor = sensors[random(0, sensors.size() - 1)];
+      *device.memory(sensor->getAddress()) += random(0, 2) - 1;
+    }
+  }
+
+  void write() {
+    if (random(0, 1) == 0) {
+      OPTOLINKNumber* number = numbers[random(0, numbers.size() - 1)];
+      number->make_call(random(0, number->traits.get_max_value()));
+    } else {
+      OPTOLINKSwitch* sw = switches[random(0, switches.size() - 1)];
+      if (random(0, 1)) {
+        sw->turn_on();
+      } else {
+        sw->turn_off();
+      }
+    }
+  }
+
+  float deviceValue(Datapoint* dp) {
+    const uint8_t* raw = device.memory(dp->getAddress());
+    switch (dp->getLength()) {
+    case 1:
+      return dp->getMask() ? (raw[0] & dp->getMask()) >> dp->getShift() : raw[0];
+    case 2:
+      return (int16_t) (raw[1] << 8 | raw[0]);
+    default:
+      return (uint32_t) (raw[3] << 24 | raw[2] << 16 | raw[1] << 8 | raw[0]);
+    }
+  }
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  uint32_t days = argc > 1 ? atoi(argv[1]) : 21;
+  auto started = std::chrono::steady_clock::now();
+
+  Diagnostics::setHeapProbe(&freeHeap);
+  Soak* soak = new Soak();
+  soak->setup();
+  check(soak->sensors.size() + soak->invalid.size() + soak->numbers.size() + soak->switches.size() == 200, "200 datapoints");
+
+  soak->device.setNoise(0.005f, 0.002f, 0.002f);
+  uint32_t nextReboot = soak->clock.now() + soak->random(DAY, 3 * DAY);
+  uint32_t warmHeapLowWater = 0;
+  size_t warmHeapInUse = 0;
+  uint32_t warmReboots = 0;
+  uint32_t cyclesPerDay = DAY / UPDATE_INTERVAL;
+  uint32_t cycles = days * cyclesPerDay;  // the clock itself wraps after 49.7 days
+  std::vector<DayStats> daily;
+  uint32_t dayAnswers = 0;
+  uint32_t dayErrors = 0;
+  for (uint32_t cycle = 0; cycle < cycles; ++cycle) {
+    soak->drift();
+    if (cycle % 20 == 0) soak->write();
+    if ((int32_t) (soak->clock.now() - nextReboot) >= 0) {
+      soak->device.reboot(soak->random(MINUTE, 3 * MINUTE));
+      nextReboot += soak->random(DAY, 3 * DAY);
+    }
+    soak->run(UPDATE_INTERVAL);
+
+    // a reboot with a full queue is the worst case, several of them happen in the first third
+    if (cycle == cycles / 3) {
+      warmHeapLowWater = soak->hub.getDiagnostics().getHeapLowWater();
+      warmHeapInUse = heapInUse;
+      warmReboots = soak->device.getCounters().reboots;
+    }
+
+    // daily report, like diagnostics_interval: 24h would log it; it resets the latency histogram
+    if ((cycle + 1) % cyclesPerDay == 0) {
+      Diagnostics& diagnostics = soak->hub.getDiagnostics();
+      uint32_t answers = soak->hub.getAnswerCount() - dayAnswers;
+      uint32_t errors = soak->hub.getErrorCount() - dayErrors;
+      daily.push_back({diagnostics.percentile(50), diagnostics.percentile(99), answers > 0 ? (float) errors / answers : 1.0f});
+      dayAnswers = soak->hub.getAnswerCount();
+      dayErrors = soak->hub.getErrorCount();
+      soak->hub.logDiagnostics();
+      printf("day %zu: %u answers, %u errors (%.2f%%), latency p50 <= %u ms, p99 <= %u ms\n", daily.size(), answers, errors,
+             100.0f * daily.back().errorRate, daily.back().p50, daily.back().p99);
+    }
+  }
+
+  // quiet phase: every datapoint is read again without noise
+  soak->device.setNoise(0.0f, 0.0f, 0.0f);
+  soak->run(10 * MINUTE);
+  uint32_t waited = 0;
+  while (soak->hub.getDiagnostics().getLive() > 0 && waited < UPDATE_INTERVAL) {
+    soak->run(10);
+    waited += 10;
+  }
+
+  Diagnostics& diagnostics = soak->hub.getDiagnostics();
+  const SimulatedVitotronic::Counters& device = soak->device.getCounters();
+  printf("%u days: %u reads, %u writes, %u error frames, %u corrupted, %u dropped, %u nacked, %u reboots\n",
+         days, device.reads, device.writes, device.errors, device.corrupted, device.dropped, device.nacked, device.reboots);
+  printf("hub: %u answers, %u errors, %u stalls, %u skipped writes\n", soak->hub.getAnswerCount(),
+         soak->hub.getErrorCount(), soak->hub.getStallCount(), soak->hub.getSkippedWriteCount());
+  printf("live requests %u (max %u), queue max %zu, publish queue max %zu, heap min %u (after warm-up: %u), heap in use %zu (after warm-up: %zu)\n",
+         diagnostics.getLive(), diagnostics.getLiveHighWater(), soak->hub.getQueueHighWater(),
+         soak->hub.getPublishHighWater(), diagnostics.getHeapLowWater(), warmHeapLowWater, heapInUse, warmHeapInUse);
+
+  // the run actually exercised the error paths
+  check(device.corrupted > 0 && device.dropped > 0 && device.nacked > 0, "line noise was injected");
+  check(device.reboots >= days / 3, "the device rebooted");
+  check(warmReboots > 0 || days < 9, "warm-up covered a reboot");
+  check(device.writes > 0, "values were written");
+  check(soak->hub.getErrorCount() > 0, "errors were reported");
+  // unknown addresses cost frames only when they are probed, not in every cycle
+  uint32_t probes = days * (DAY / HOUR) * soak->invalid.size();
+  check(device.errors <= 2 * probes, "unknown addresses only probed once per reprobe interval");
+
+  // nothing accumulates
+  check(diagnostics.getLive() == 0, "no request contexts alive once the link is idle");
+  check(diagnostics.getLiveHighWater() <= VITOWIFI_MAX_QUEUE_LENGTH, "live requests bounded by the queue");
+  check(soak->hub.getQueueHighWater() < VITOWIFI_MAX_QUEUE_LENGTH, "request queue never full");
+  check(soak->hub.getPublishHighWater() <= soak->ungrouped, "publish queue bounded by the ungrouped datapoints");
+  check(warmHeapLowWater > 0 && diagnostics.getHeapLowWater() + 1024 >= warmHeapLowWater, "heap minimum stable after warm-up");
+  check(heapInUse <= warmHeapInUse + 1024, "heap in use stable after warm-up");
+
+  // latency and error rate stay bounded every day and do not creep up after warm-up
+  for (const DayStats& day : daily) {
+    check(day.p50 <= LATENCY_P50_MAX && day.p99 <= LATENCY_P99_MAX, "daily latency bounded");
+    check(day.errorRate <= ERROR_RATE_MAX, "daily error rate bounded");
+  }
+  if (daily.size() >= 3) {
+    size_t third = daily.size() / 3;
+    size_t last = daily.size() - third;
+    float earlyRate = mean(daily, third, last, &DayStats::errorRate);
+    float lateRate = mean(daily, last, daily.size(), &DayStats::errorRate);
+    check(lateRate <= 1.5f * earlyRate + 0.005f, "error rate does not trend upward");
+    uint32_t earlyP99 = 0;
+    uint32_t lateP99 = 0;
+    for (size_t i = third; i < last; ++i) earlyP99 = std::max(earlyP99, daily[i].p99);
+    for (size_t i = last; i < daily.size(); ++i) lateP99 = std::max(lateP99, daily[i].p99);
+    check(lateP99 <= earlyP99, "latency does not trend upward");
+  }
+
+  // the entities agree with the device
+  for (OPTOLINKSensor* sensor : soak->sensors) {
+    check(!sensor->isStale() && sensor->state == soak->deviceValue(sensor), "sensor matches the device");
+  }
+  for (OPTOLINKSensor* sensor : soak->invalid) {
+    check(sensor->isQuarantined(), "unknown address quarantined");
+  }
+  for (OPTOLINKNumber* number : soak->numbers) {
+    check(number->getLastUpdate() == 0 && number->state == soak->deviceValue(number), "number matches the device");
+  }
+  for (OPTOLINKSwitch* sw : soak->switches) {
+    check(sw->getLastUpdate() == 0 && sw->state == (soak->deviceValue(sw) != 0), "switch matches the device");
+  }
+
+  printf("%s after %.1f s\n", failures == 0 ? "PASS" : "FAIL",
+         std::chrono::duration<float>(std::chrono::steady_clock::now() - started).count());
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "esphome/core/component.h"
+
+namespace esphome {
+namespace number {
+
+class NumberTraits {
+ public:
+  void set_min_value(float min_value) { this->min_value_ = min_value; }
+  float get_min_value() const { return this->min_value_; }
+  void set_max_value(float max_value) { this->max_value_ = max_value; }
+  float get_max_value() const { return this->max_value_; }
+  void set_step(float step) { this->step_ = step; }
+  float get_step() const { return this->step_; }
+
+ protected:
+  float min_value_{0.0f};
+  float max_value_{100.0f};
+  float step_{0.0f};
+};
+
+class Number : public EntityBase {
+ public:
+  void publish_state(float state) {
+    this->state = state;
+    this->has_state_ = true;
+  }
+
+  /**
+   * @brief Stands in for NumberCall, sets the value as a frontend would.
+   */
+  void make_call(float value) { this->control(value); }
+
+  float state{NAN};
+  NumberTraits traits;
+
+ protected:
+  virtual void control(float value) = 0;
+};
+
+}  // namespace number
+}  // namespace esphome
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "esphome/core/component.h"
+
+namespace esphome {
+namespace sensor {
+
+class Sensor : public EntityBase {
+ public:
+  void publish_state(float state) {
+    this->state = state;
+    this->has_state_ = true;
+    ++this->publish_count;
+  }
+  float get_state() const { return this->state; }
+
+  float state{NAN};
+  uint32_t publish_count{0};  // for tests
+};
+
+}  // namespace sensor
+}  // namespace esphome
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "esphome/core/component.h"
+
+namespace esphome {
+namespace switch_ {
+
+class Switch : public EntityBase {
+ public:
+  void publish_state(bool state) {
+    this->state = state;
+    this->has_state_ = true;
+  }
+  void turn_on() { this->write_state(true); }
+  void turn_off() { this->write_state(false); }
+
+  bool state{false};
+
+ protected:
+  CallbackManager<void(bool)> state_callback_;
+  virtual void write_state(bool state) = 0;
+};
+
+}  // namespace switch_
+}  // namespace esphome
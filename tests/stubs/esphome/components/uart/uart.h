@@ -0,0 +1,42 @@
+#pragma once
+
+#include "esphome/components/uart/uart_component.h"
+#include "esphome/core/component.h"
+
+namespace esphome {
+namespace uart {
+
+class UARTDevice {
+ public:
+  UARTDevice() = default;
+  explicit UARTDevice(UARTComponent *parent) : parent_(parent) {}
+
+  void set_uart_parent(UARTComponent *parent) { this->parent_ = parent; }
+
+  void write_byte(uint8_t data) { this->parent_->write_array(&data, 1); }
+  void write_array(const uint8_t *data, size_t len) { this->parent_->write_array(data, len); }
+  bool read_byte(uint8_t *data) { return this->parent_->read_byte(data); }
+  bool peek_byte(uint8_t *data) { return this->parent_->peek_byte(data); }
+  int available() { return this->parent_->available(); }
+  void flush() { this->parent_->flush(); }
+
+  int read() {
+    uint8_t data;
+    if (!this->read_byte(&data)) return -1;
+    return data;
+  }
+  int peek() {
+    uint8_t data;
+    if (!this->peek_byte(&data)) return -1;
+    return data;
+  }
+
+  void check_uart_settings(uint32_t baud_rate, uint8_t stop_bits = 1,
+                           UARTParityOptions parity = UART_CONFIG_PARITY_NONE, uint8_t data_bits = 8) {}
+
+ protected:
+  UARTComponent *parent_{nullptr};
+};
+
+}  // namespace uart
+}  // namespace esphome
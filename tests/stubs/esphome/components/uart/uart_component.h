@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace uart {
+
+enum UARTParityOptions {
+  UART_CONFIG_PARITY_NONE,
+  UART_CONFIG_PARITY_EVEN,
+  UART_CONFIG_PARITY_ODD,
+};
+
+/**
+ * @brief Bus the devices talk through, implemented by the fake UART of the tests.
+ */
+class UARTComponent {
+ public:
+  virtual ~UARTComponent() {}
+  virtual void write_array(const uint8_t *data, size_t len) = 0;
+  virtual bool peek_byte(uint8_t *data) = 0;
+  virtual bool read_array(uint8_t *data, size_t len) = 0;
+  virtual int available() = 0;
+  virtual void flush() {}
+
+  bool read_byte(uint8_t *data) { return this->read_array(data, 1); }
+};
+
+}  // namespace uart
+}  // namespace esphome
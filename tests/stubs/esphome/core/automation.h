@@ -0,0 +1,49 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "esphome/core/component.h"
+
+namespace esphome {
+
+template<typename... Ts> class Trigger {
+ public:
+  void trigger(Ts... x) { ++this->count; }
+  uint32_t count{0};  // number of times the trigger fired, for tests
+};
+
+template<typename... Ts> class Action {
+ public:
+  virtual ~Action() {}
+  virtual void play(Ts... x) = 0;
+};
+
+template<typename T, typename... X> class TemplatableValue {
+ public:
+  TemplatableValue() {}
+  TemplatableValue(T value) : value_(value) {}
+  T value(X... x) { return this->value_; }
+
+ protected:
+  T value_{};
+};
+
+#define TEMPLATABLE_VALUE(type, name) \
+ protected: \
+  TemplatableValue<type, Ts...> name##_{}; \
+\
+ public: \
+  template<typename V> void set_##name(V name) { this->name##_ = name; }
+
+template<typename T> class Parented {
+ public:
+  Parented() {}
+  Parented(T *parent) : parent_(parent) {}
+  void set_parent(T *parent) { this->parent_ = parent; }
+
+ protected:
+  T *parent_{nullptr};
+};
+
+}  // namespace esphome
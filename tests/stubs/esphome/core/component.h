@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "esphome/core/defines.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+#include "esphome/core/optional.h"
+
+namespace esphome {
+
+namespace setup_priority {
+extern const float BUS;
+extern const float DATA;
+extern const float HARDWARE;
+extern const float LATE;
+}  // namespace setup_priority
+
+/**
+ * @brief Minimal component for host builds. There is no scheduler: timeouts
+ *        and intervals are dropped, deferred functions run immediately.
+ */
+class Component {
+ public:
+  virtual ~Component() {}
+  virtual void setup() {}
+  virtual void loop() {}
+  virtual void dump_config() {}
+  virtual float get_setup_priority() const { return 0.0f; }
+  void mark_failed() { this->failed_ = true; }
+  bool is_failed() const { return this->failed_; }
+  void status_set_warning(const char *message = "") { this->warning_ = true; }
+  void status_clear_warning() { this->warning_ = false; }
+  bool status_has_warning() const { return this->warning_; }
+
+ protected:
+  void set_timeout(const std::string &name, uint32_t timeout, std::function<void()> &&f) {}
+  void set_timeout(uint32_t timeout, std::function<void()> &&f) {}
+  bool cancel_timeout(const std::string &name) { return false; }
+  void set_interval(const std::string &name, uint32_t interval, std::function<void()> &&f) {}
+  void set_interval(uint32_t interval, std::function<void()> &&f) {}
+  bool cancel_interval(const std::string &name) { return false; }
+  void defer(std::function<void()> &&f) { f(); }
+  void defer(const std::string &name, std::function<void()> &&f) { f(); }
+
+  bool failed_{false};
+  bool warning_{false};
+};
+
+class PollingComponent : public Component {
+ public:
+  PollingComponent() {}
+  explicit PollingComponent(uint32_t update_interval) : update_interval_(update_interval) {}
+  virtual void set_update_interval(uint32_t update_interval) { this->update_interval_ = update_interval; }
+  virtual uint32_t get_update_interval() const { return this->update_interval_; }
+  virtual void update() = 0;
+
+ protected:
+  uint32_t update_interval_{0};
+};
+
+class EntityBase {
+ public:
+  void set_name(const std::string &name) { this->name_ = name; }
+  const std::string &get_name() const { return this->name_; }
+  bool is_internal() const { return false; }
+  bool has_state() const { return this->has_state_; }
+  void set_has_state(bool state) { this->has_state_ = state; }
+
+ protected:
+  std::string name_;
+  bool has_state_{false};
+};
+
+}  // namespace esphome
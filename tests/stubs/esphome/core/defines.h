@@ -0,0 +1,6 @@
+#pragma once
+
+// host build, no target specific features
+#ifndef USE_HOST
+#define USE_HOST
+#endif
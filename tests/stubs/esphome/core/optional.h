@@ -0,0 +1,10 @@
+#pragma once
+
+#include <optional>
+
+namespace esphome {
+
+template<typename T> using optional = std::optional<T>;
+inline constexpr auto nullopt = std::nullopt;
+
+}  // namespace esphome
@@ -0,0 +1,87 @@
+/*
+  host.cpp - Host implementation of the ESPHome stubs
+
+  Copyright (C) 2026  vitoconnect contributors
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Implementation of the ESPHome stubs for host builds.
+
+#include <chrono>
+#include <cstdarg>
+#include <cstdlib>
+#include <thread>
+
+#include "esphome/core/component.h"
+
+namespace esphome {
+
+namespace setup_priority {
+const float BUS = 1000.0f;
+const float HARDWARE = 800.0f;
+const float DATA = 600.0f;
+const float LATE = -100.0f;
+}  // namespace setup_priority
+
+static int initialLogLevel() {
+  const char *level = getenv("VITOCONNECT_LOG_LEVEL");
+  return level ? atoi(level) : ESPHOME_LOG_LEVEL_ERROR;
+}
+
+int host_log_level = initialLogLevel();
+
+void host_log(int level, const char *tag, const char *format, ...) {
+  if (level > host_log_level) return;
+  static const char LETTERS[] = "NEWICDVV";
+  printf("[%c][%s] ", LETTERS[level], tag);
+  va_list args;
+  va_start(args, format);
+  vprintf(format, args);
+  va_end(args);
+  printf("\n");
+}
+
+static const auto START = std::chrono::steady_clock::now();
+
+uint32_t millis() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - START).count();
+}
+
+uint32_t micros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - START).count();
+}
+
+void delay(uint32_t ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+
+std::string str_sprintf(const char *format, ...) {
+  char buffer[256];
+  va_list args;
+  va_start(args, format);
+  vsnprintf(buffer, sizeof(buffer), format, args);
+  va_end(args);
+  return buffer;
+}
+
+std::string format_hex_pretty(const uint8_t *data, size_t length) {
+  std::string result;
+  char buffer[4];
+  for (size_t i = 0; i < length; ++i) {
+    snprintf(buffer, sizeof(buffer), i == 0 ? "%02X" : ".%02X", data[i]);
+    result += buffer;
+  }
+  return result;
+}
+
+}  // namespace esphome
@@ -0,0 +1,273 @@
+/*
+  trace_test.cpp - Golden trace conformance test of both protocols
+
+  Copyright (C) 2026  vitoconnect contributors
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Replays a golden trace against OptolinkP300 or OptolinkKW and checks the
+  bytes sent, their timing and the callbacks. Time only moves through a
+  VirtualClock, one millisecond per loop() call.
+
+  Trace format, one step per line, '#' starts a comment:
+
+    protocol P300|KW             protocol under test, first line
+    begin                        call begin()
+    read <address> <length>      queue a read request
+    write <address> <length> <bytes...>
+                                 queue a write request
+    rx <bytes...>                the device sends these bytes
+    tx <min>..<max> <bytes...>   the link must send these bytes within
+                                 min..max ms after the previous step
+    data <min>..<max> <bytes...> onData must be called with these bytes
+    error <min>..<max> <ERROR>   onError must be called with this error
+    wait <ms>                    nothing may be sent or reported for ms
+
+  The trace hook of the optolink must record exactly the bytes on the wire,
+  so a trace logged on a device (`trace: true`) can be added to the corpus.
+*/
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "vitoconnect_optolinkKW.h"
+#include "vitoconnect_optolinkP300.h"
+#include "fake_uart.h"
+
+using namespace esphome::vitoconnect;
+
+namespace {
+
+struct Event {
+  bool error;
+  uint8_t code;
+  std::vector<uint8_t> data;
+};
+
+class TraceRunner {
+ public:
+  explicit TraceRunner(const std::string& path) : _path(path), _device(&_uart) {}
+  ~TraceRunner() { delete _link; }
+
+  bool run() {
+    std::ifstream file(_path);
+    if (!file) return _fail("cannot open trace");
+
+    std::string line;
+    while (std::getline(file, line)) {
+      ++_line;
+      line = line.substr(0, line.find('#'));
+      std::istringstream tokens(line);
+      std::string op;
+      if (!(tokens >> op)) continue;
+      if (!_step(op, tokens)) return false;
+    }
+    return _finish();
+  }
+
+ private:
+  bool _step(const std::string& op, std::istringstream& tokens) {
+    if (op == "protocol") {
+      std::string protocol;
+      tokens >> protocol;
+      if (protocol == "P300") {
+        _link = new OptolinkP300(&_device);
+      } else if (protocol == "KW") {
+        _link = new OptolinkKW(&_device);
+      } else {
+        return _fail("unknown protocol " + protocol);
+      }
+      _link->setClock(&_clock);
+      _link->onData(&TraceRunner::_onData);
+      _link->onError(&TraceRunner::_onError);
+      _link->onTrace(&TraceRunner::_onTrace, this);
+      _current = this;
+      return true;
+    }
+    if (_link == nullptr) return _fail("trace must start with protocol");
+
+    if (op == "begin") {
+      _link->begin();
+      return true;
+    }
+    if (op == "read" || op == "write") {
+      unsigned address = 0, length = 0;
+      tokens >> std::hex >> address >> std::dec >> length;
+      if (op == "read") {
+        _link->read(address, length);
+      } else {
+        std::vector<uint8_t> data = _bytes(tokens);
+        if (data.size() != length) return _fail("write data does not match its length");
+        _link->write(address, length, data.data());
+      }
+      return true;
+    }
+    if (op == "rx") {
+      _uart.feed(_bytes(tokens));
+      return true;
+    }
+    if (op == "wait") {
+      uint32_t ms = 0;
+      tokens >> ms;
+      uint32_t start = _clock.now();
+      while (_clock.now() - start < ms) {
+        _link->loop();
+        if (_uart.tx.size() > _txChecked) return _fail("unexpected transmission " + _hex(_uart.tx, _txChecked));
+        if (!_events.empty()) return _fail("unexpected callback");
+        _clock.advance(1);
+      }
+      return true;
+    }
+    if (op == "tx" || op == "data" || op == "error") {
+      uint32_t min = 0, max = 0;
+      std::string window;
+      tokens >> window;
+      if (sscanf(window.c_str(), "%u..%u", &min, &max) != 2) return _fail("expected a window min..max");
+      std::vector<uint8_t> bytes;
+      uint8_t code = 0;
+      if (op == "error") {
+        std::string name;
+        tokens >> name;
+        while (code <= VERIFICATION && name != optolinkErrorToString(code)) ++code;
+        if (code > VERIFICATION) return _fail("unknown error " + name);
+      } else {
+        bytes = _bytes(tokens);
+      }
+      return _expect(op, min, max, bytes, code);
+    }
+    return _fail("unknown step " + op);
+  }
+
+  bool _expect(const std::string& op, uint32_t min, uint32_t max, const std::vector<uint8_t>& bytes, uint8_t code) {
+    bool tx = op == "tx";
+    uint32_t start = _clock.now();
+    for (;;) {
+      _link->loop();
+      if (tx) {
+        if (!_events.empty()) return _fail("unexpected callback while waiting for transmission");
+        if (_uart.tx.size() - _txChecked >= bytes.size()) break;
+      } else {
+        if (_uart.tx.size() > _txChecked) return _fail("unexpected transmission " + _hex(_uart.tx, _txChecked));
+        if (!_events.empty()) break;
+      }
+      if (_clock.now() - start >= max) return _fail(op + " not seen within " + std::to_string(max) + " ms");
+      _clock.advance(1);
+    }
+
+    uint32_t elapsed = _clock.now() - start;
+    if (elapsed < min) return _fail(op + " after " + std::to_string(elapsed) + " ms, expected at least " + std::to_string(min));
+
+    if (tx) {
+      std::vector<uint8_t> sent(_uart.tx.begin() + _txChecked, _uart.tx.begin() + _txChecked + bytes.size());
+      if (sent != bytes) return _fail("sent " + _hex(sent, 0) + ", expected " + _hex(bytes, 0));
+      _txChecked += bytes.size();
+      return true;
+    }
+
+    Event event = _events.front();
+    _events.erase(_events.begin());
+    if (op == "error") {
+      if (!event.error) return _fail("onData instead of onError");
+      if (event.code != code) return _fail(std::string("error ") + optolinkErrorToString(event.code));
+    } else {
+      if (event.error) return _fail(std::string("onError ") + optolinkErrorToString(event.code) + " instead of onData");
+      if (event.data != bytes) return _fail("data " + _hex(event.data, 0) + ", expected " + _hex(bytes, 0));
+    }
+    return true;
+  }
+
+  bool _finish() {
+    if (_uart.tx.size() > _txChecked) return _fail("unchecked transmission " + _hex(_uart.tx, _txChecked));
+    if (!_events.empty()) return _fail("unchecked callback");
+
+    // the recorded trace must match the wire: all sent bytes, and the bytes read so far
+    // (received bytes are reported once the next frame is sent or the request ends)
+    if (_traceTx != _uart.tx) return _fail("trace hook recorded TX " + _hex(_traceTx, 0));
+    if (_traceRx.size() > _uart.rxConsumed) return _fail("trace hook recorded more RX than was read");
+    return true;
+  }
+
+  std::vector<uint8_t> _bytes(std::istringstream& tokens) {
+    std::vector<uint8_t> bytes;
+    unsigned byte;
+    while (tokens >> std::hex >> byte) bytes.push_back(byte);
+    return bytes;
+  }
+
+  static std::string _hex(const std::vector<uint8_t>& bytes, size_t from) {
+    std::string result;
+    char buffer[4];
+    for (size_t i = from; i < bytes.size(); ++i) {
+      snprintf(buffer, sizeof(buffer), "%02X ", bytes[i]);
+      result += buffer;
+    }
+    return result;
+  }
+
+  bool _fail(const std::string& message) {
+    printf("%s:%d: %s (at %u ms)\n", _path.c_str(), _line, message.c_str(), _clock.now());
+    return false;
+  }
+
+  static void _onData(uint8_t* data, uint8_t len, void* arg) {
+    _current->_events.push_back({false, 0, std::vector<uint8_t>(data, data + len)});
+  }
+
+  static void _onError(uint8_t error, void* arg) {
+    _current->_events.push_back({true, error, {}});
+  }
+
+  static void _onTrace(bool tx, const uint8_t* data, uint8_t len, uint32_t timestamp, void* arg) {
+    TraceRunner* runner = reinterpret_cast<TraceRunner*>(arg);
+    std::vector<uint8_t>& trace = tx ? runner->_traceTx : runner->_traceRx;
+    trace.insert(trace.end(), data, data + len);
+  }
+
+  static TraceRunner* _current;  // the callbacks of requests queued by the trace carry no argument
+
+  std::string _path;
+  int _line = 0;
+  VirtualClock _clock;
+  FakeUart _uart;
+  esphome::uart::UARTDevice _device;
+  Optolink* _link = nullptr;
+  size_t _txChecked = 0;
+  std::vector<Event> _events;
+  std::vector<uint8_t> _traceTx;
+  std::vector<uint8_t> _traceRx;
+};
+
+TraceRunner* TraceRunner::_current = nullptr;
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    printf("usage: %s <trace>...\n", argv[0]);
+    return 2;
+  }
+  int failed = 0;
+  for (int i = 1; i < argc; ++i) {
+    TraceRunner runner(argv[i]);
+    bool ok = runner.run();
+    printf("%s %s\n", ok ? "PASS" : "FAIL", argv[i]);
+    failed += ok ? 0 : 1;
+  }
+  return failed == 0 ? 0 : 1;
+}
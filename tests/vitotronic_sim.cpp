@@ -0,0 +1,150 @@
+/*
+  vitotronic_sim.cpp - Simulated Vitotronic answering P300 and KW requests
+
+  Copyright (C) 2026  vitoconnect contributors
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "vitotronic_sim.h"
+
+#include <cstring>
+
+namespace esphome {
+namespace vitoconnect {
+
+static uint8_t checksum(const std::vector<uint8_t>& frame) {
+  uint8_t sum = 0;
+  for (size_t i = 1; i < frame.size(); ++i) sum += frame[i];
+  return sum;
+}
+
+SimulatedVitotronic::SimulatedVitotronic(FakeUart* uart, MonotonicClock* clock, uint32_t seed) :
+  _uart(uart),
+  _clock(clock),
+  _random(seed),
+  _memory(0x10000, 0),
+  _invalid(0x10000, false) {}
+
+void SimulatedVitotronic::setNoise(float corrupt, float drop, float nack) {
+  _corrupt = corrupt;
+  _drop = drop;
+  _nack = nack;
+}
+
+void SimulatedVitotronic::reboot(uint32_t duration) {
+  ++_counters.reboots;
+  _silentUntil = _clock->now() + duration;
+  _p300 = false;
+  _rx.clear();
+  _out.clear();
+}
+
+bool SimulatedVitotronic::_chance(float probability) {
+  return probability > 0.0f && std::uniform_real_distribution<float>(0.0f, 1.0f)(_random) < probability;
+}
+
+void SimulatedVitotronic::_send(uint32_t delay, std::vector<uint8_t> bytes) {
+  uint32_t at = _clock->now() + delay;
+  if (!_out.empty() && (int32_t) (_out.back().at - at) > 0) at = _out.back().at;  // keep the order on the wire
+  _out.push_back({at, std::move(bytes)});
+}
+
+void SimulatedVitotronic::loop() {
+  // everything sent while rebooting is lost
+  bool silent = (int32_t) (_silentUntil - _clock->now()) > 0;
+  if (!silent) _rx.insert(_rx.end(), _uart->tx.begin(), _uart->tx.end());
+  _uart->tx.clear();
+  if (!silent) _parse();
+
+  while (!_out.empty() && (int32_t) (_clock->now() - _out.front().at) >= 0) {
+    _uart->feed(_out.front().bytes);
+    _out.pop_front();
+  }
+}
+
+void SimulatedVitotronic::_parse() {
+  size_t pos = 0;
+  while (pos < _rx.size()) {
+    uint8_t byte = _rx[pos];
+    if (byte == 0x04) {
+      // back to KW mode, announced with a sync byte
+      _p300 = false;
+      _send(10, {0x05});
+      ++pos;
+    } else if (byte == 0x16) {
+      if (_rx.size() - pos < 3) break;
+      if (_rx[pos + 1] == 0x00 && _rx[pos + 2] == 0x00) {
+        _p300 = true;
+        _send(5, {0x06});
+      }
+      pos += 3;
+    } else if (byte == 0x41 && _p300) {
+      if (_rx.size() - pos < 2) break;
+      size_t length = _rx[pos + 1] + 3u;
+      if (_rx.size() - pos < length) break;
+      std::vector<uint8_t> frame(_rx.begin() + pos, _rx.begin() + pos + length - 1);
+      if (checksum(frame) != _rx[pos + length - 1]) {
+        _send(5, {0x15});
+      } else {
+        _answer(&_rx[pos]);
+      }
+      pos += length;
+    } else {
+      // acknowledgements of our answers and anything sent in KW mode
+      ++pos;
+    }
+  }
+  _rx.erase(_rx.begin(), _rx.begin() + pos);
+}
+
+void SimulatedVitotronic::_answer(const uint8_t* frame) {
+  if (_chance(_nack)) {
+    ++_counters.nacked;
+    _send(5, {0x15});
+    return;
+  }
+  _send(5, {0x06});
+  if (_chance(_drop)) {
+    ++_counters.dropped;
+    return;
+  }
+
+  bool write = frame[3] == 0x02;
+  uint16_t address = frame[4] << 8 | frame[5];
+  uint8_t length = frame[6];
+  std::vector<uint8_t> answer = {0x41, 0x05, 0x01, frame[3], frame[4], frame[5], length};
+  bool invalid = false;
+  for (uint8_t i = 0; i < length; ++i) invalid |= _invalid[(address + i) & 0xFFFF];
+  if (invalid) {
+    ++_counters.errors;
+    answer[2] = 0x03;
+  } else if (write) {
+    ++_counters.writes;
+    memcpy(&_memory[address], &frame[7], length);
+  } else {
+    ++_counters.reads;
+    answer[1] += length;
+    answer.insert(answer.end(), &_memory[address], &_memory[address] + length);
+  }
+  answer.push_back(checksum(answer));
+  if (_chance(_corrupt)) {
+    ++_counters.corrupted;
+    answer.back() ^= 0x5A;
+  }
+  _send(std::uniform_int_distribution<uint32_t>(20, 60)(_random), answer);
+}
+
+}  // namespace vitoconnect
+}  // namespace esphome
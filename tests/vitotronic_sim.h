@@ -0,0 +1,112 @@
+/*
+  vitotronic_sim.h - Simulated Vitotronic answering P300 and KW requests
+
+  Copyright (C) 2026  vitoconnect contributors
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <deque>
+#include <random>
+#include <vector>
+
+#include "vitoconnect_monotonic.h"
+#include "fake_uart.h"
+
+namespace esphome {
+namespace vitoconnect {
+
+/**
+ * @brief Vitotronic on the other side of the fake UART, speaking P300.
+ *
+ * The device answers after a random delay, can be made to corrupt, drop
+ * or reject frames, and falls back to KW mode after a reboot, so the link
+ * has to reset and initialise it again.
+ */
+class SimulatedVitotronic {
+ public:
+  SimulatedVitotronic(FakeUart* uart, MonotonicClock* clock, uint32_t seed);
+
+  uint8_t* memory(uint16_t address) { return &_memory[address]; }
+
+  /**
+   * @brief Reads and writes covering the address are answered with an error frame.
+   */
+  void setInvalid(uint16_t address) { _invalid[address] = true; }
+
+  /**
+   * @brief Probability (0..1) of a corrupted checksum, a dropped answer and
+   *        a NACK for every request.
+   */
+  void setNoise(float corrupt, float drop, float nack);
+
+  /**
+   * @brief Go silent for the given time (ms), KW mode afterwards.
+   */
+  void reboot(uint32_t duration);
+
+  /**
+   * @brief Take the bytes sent by the link (the UART's TX buffer is drained)
+   *        and deliver answers that are due.
+   */
+  void loop();
+
+  /**
+   * @brief Time (ms) the next answer is due, UINT32_MAX if none is scheduled.
+   */
+  uint32_t nextEvent() const { return _out.empty() ? UINT32_MAX : _out.front().at; }
+
+  bool isP300() const { return _p300; }
+
+  struct Counters {
+    uint32_t reads;
+    uint32_t writes;
+    uint32_t errors;
+    uint32_t corrupted;
+    uint32_t dropped;
+    uint32_t nacked;
+    uint32_t reboots;
+  };
+  const Counters& getCounters() const { return _counters; }
+
+ private:
+  void _parse();
+  void _answer(const uint8_t* frame);
+  void _send(uint32_t delay, std::vector<uint8_t> bytes);
+  bool _chance(float probability);
+
+  struct Output {
+    uint32_t at;
+    std::vector<uint8_t> bytes;
+  };
+
+  FakeUart* _uart;
+  MonotonicClock* _clock;
+  std::mt19937 _random;
+  std::vector<uint8_t> _rx;
+  std::deque<Output> _out;
+  bool _p300 = false;
+  uint32_t _silentUntil = 0;
+  float _corrupt = 0.0f;
+  float _drop = 0.0f;
+  float _nack = 0.0f;
+  Counters _counters = {};
+  std::vector<uint8_t> _memory;
+  std::vector<bool> _invalid;
+};
+
+}  // namespace vitoconnect
+}  // namespace esphome